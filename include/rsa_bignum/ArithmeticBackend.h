@@ -0,0 +1,34 @@
+#ifndef RSA_BIGNUM_ARITHMETIC_BACKEND_H
+#define RSA_BIGNUM_ARITHMETIC_BACKEND_H
+
+#include "rsa_bignum/LargeNumber.h"
+#include <vector>
+#if defined(RSA_USE_GMP)
+#include <gmp.h>
+#endif
+
+namespace NativeBackend
+{
+    const char *name();
+    std::vector<int> multiply(DigitSpan first, DigitSpan second);
+    DigitDivisionResult divide(DigitSpan dividend, DigitSpan divisor);
+    std::vector<int> powerModulo(const std::vector<int> &base, const std::vector<int> &exponent, const std::vector<int> &modulus);
+}
+
+#if defined(RSA_USE_GMP)
+namespace GmpBackend
+{
+    const char *name();
+    void toInteger(mpz_t result, DigitSpan digits);
+    std::vector<int> fromInteger(const mpz_t value);
+    std::vector<int> multiply(DigitSpan first, DigitSpan second);
+    DigitDivisionResult divide(DigitSpan dividend, DigitSpan divisor);
+    std::vector<int> powerModulo(const std::vector<int> &base, const std::vector<int> &exponent, const std::vector<int> &modulus);
+}
+
+namespace ArithmeticBackend = GmpBackend;
+#else
+namespace ArithmeticBackend = NativeBackend;
+#endif
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef RSA_BIGNUM_BATCH_DRIVER_H
+#define RSA_BIGNUM_BATCH_DRIVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct BatchFileResult
+{
+    std::string name;
+    uintmax_t bytes = 0;
+    double seconds = 0;
+    bool succeeded = false;
+    std::string error;
+};
+
+struct BatchOptions
+{
+    size_t threads = 0;
+    size_t processes = 0;
+    bool pinNuma = false;
+};
+
+namespace BatchDriver
+{
+    typedef std::function<void(const std::string &inputPath, const std::string &outputPath)> FileTask;
+    std::vector<BatchFileResult> run(const std::string &inputDirectory, const std::string &outputDirectory, const FileTask &task, const BatchOptions &options);
+    void printSummary(std::ostream &os, const std::vector<BatchFileResult> &results, double wallSeconds);
+    bool processDirectory(const std::string &inputDirectory, const std::string &outputDirectory, const FileTask &task, const BatchOptions &options, std::ostream &summary);
+};
+
+#endif
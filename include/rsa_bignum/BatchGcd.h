@@ -0,0 +1,14 @@
+#ifndef RSA_BIGNUM_BATCH_GCD_H
+#define RSA_BIGNUM_BATCH_GCD_H
+
+#include "rsa_bignum/LargeNumber.h"
+#include <vector>
+
+namespace BatchGcd
+{
+    std::vector<std::vector<LargeNumber>> buildProductTree(const std::vector<LargeNumber> &moduli);
+    std::vector<LargeNumber> computeRemainders(const std::vector<std::vector<LargeNumber>> &productTree);
+    std::vector<LargeNumber> findSharedFactors(const std::vector<LargeNumber> &moduli);
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef RSA_BIGNUM_BENCHMARK_H
+#define RSA_BIGNUM_BENCHMARK_H
+
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace Benchmark
+{
+    double measureOperation(const std::function<void()> &operation);
+    void sweepMultiplication(std::ostream &output, size_t maxBits);
+    double measureCycles(const std::function<void(size_t)> &operation, size_t repetitions);
+    void measureLimbKernels(std::ostream &output);
+    size_t findCrossover(std::ostream &log, const std::string &tier, size_t &threshold, size_t first, size_t last, const std::function<std::function<void()>(size_t)> &prepare);
+    ArithmeticThresholds tuneThresholds(std::ostream &log);
+    bool compareBackends(std::ostream &output, size_t count);
+};
+
+#endif
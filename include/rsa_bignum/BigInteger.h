@@ -0,0 +1,42 @@
+#ifndef RSA_BIGNUM_BIG_INTEGER_H
+#define RSA_BIGNUM_BIG_INTEGER_H
+
+#include <string>
+#include <vector>
+
+class BigInteger
+{
+private:
+    std::string digits;
+
+public:
+    BigInteger(std::string &);
+    BigInteger(BigInteger &);
+    BigInteger(unsigned long long n = 0);
+    BigInteger(const char *);
+    BigInteger(const BigInteger &a);
+    explicit BigInteger(const std::vector<int> &);
+    friend bool Null(const BigInteger &);
+    int operator[](const int) const;
+    std::string toString();
+    std::vector<int> toDigitVector() const;
+    BigInteger &operator=(const BigInteger &);
+    BigInteger &operator++();
+    BigInteger operator++(int temp);
+    friend BigInteger &operator+=(BigInteger &, const BigInteger &);
+    friend BigInteger operator+(const BigInteger &, const BigInteger &);
+    BigInteger &operator--();
+    BigInteger operator--(int temp);
+    friend BigInteger &operator-=(BigInteger &, const BigInteger &);
+    friend BigInteger operator-(const BigInteger &, const BigInteger &);
+    friend BigInteger &operator*=(BigInteger &, const BigInteger &);
+    friend BigInteger operator*(const BigInteger &, const BigInteger &);
+    friend BigInteger &operator/=(BigInteger &, const BigInteger &);
+    friend BigInteger operator/(const BigInteger &, const BigInteger &);
+    friend BigInteger operator%(const BigInteger &, const BigInteger &);
+    friend BigInteger &operator%=(BigInteger &, const BigInteger &);
+    friend bool operator==(const BigInteger &, const BigInteger &);
+    friend bool operator<(const BigInteger &, const BigInteger &);
+};
+
+#endif
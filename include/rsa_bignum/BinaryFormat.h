@@ -0,0 +1,44 @@
+#ifndef RSA_BIGNUM_BINARY_FORMAT_H
+#define RSA_BIGNUM_BINARY_FORMAT_H
+
+#include "rsa_bignum/LargeNumber.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum RecordType
+{
+    RECORD_CANDIDATES = 1,
+    RECORD_PRIMALITY_RESULTS = 2,
+    RECORD_KEY_VALUES = 3,
+    RECORD_PRIVATE_KEYS = 4,
+    RECORD_MESSAGES = 5,
+    RECORD_MESSAGE_INDICES = 6,
+    RECORD_PUBLIC_KEYS = 7,
+    RECORD_SHARED_FACTORS = 8
+};
+
+namespace BinaryFormat
+{
+    const unsigned char VERSION = 1;
+    const size_t HEADER_SIZE = 16;
+    const unsigned long long MAX_RECORD_BYTES = 0x7FFFFFFF;
+    bool readHeader(std::string_view contents, RecordType &type, unsigned long long &count);
+    bool readRecord(std::string_view contents, size_t &position, std::string_view &magnitude, bool &negative);
+    std::string header(RecordType type, unsigned long long count);
+    void appendRecord(std::string &output, std::string_view magnitude, bool negative = false);
+    void appendInteger(std::string &output, long long value);
+    void appendHex(std::string &output, std::string_view hex);
+    void appendLargeNumber(std::string &output, const LargeNumber &number);
+    std::string_view trim(std::string_view magnitude);
+    long long toInteger(std::string_view magnitude, bool negative = false);
+    std::vector<unsigned long long> toLimbs(std::string_view magnitude);
+    std::vector<unsigned long long> toLimbs(const LargeNumber &number);
+    LargeNumber fromLimbs(const unsigned long long *limbs, size_t count, bool negative = false);
+    LargeNumber toLargeNumber(std::string_view magnitude, bool negative = false);
+    std::string toHex(std::string_view magnitude);
+    std::string fromHex(std::string_view hex);
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef RSA_BIGNUM_CONVERSION_OPERATIONS_H
+#define RSA_BIGNUM_CONVERSION_OPERATIONS_H
+
+#include "rsa_bignum/LargeNumber.h"
+#include "rsa_bignum/BigInteger.h"
+#include <string>
+#include <string_view>
+
+namespace ConversionOperations
+{
+    LargeNumber convertStringToLargeNumber(const std::string &str);
+    BigInteger convertHexBigEndianToDecimal(std::string_view hexVal);
+    std::string convertDecimalToHexBigEndian(LargeNumber decimal);
+    std::string convertBigIntegerToHexBigEndian(const BigInteger &decimal);
+    std::string convertLargeNumberToString(LargeNumber input);
+    LargeNumber convertHexToLargeNumber(std::string_view hexVal);
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef RSA_BIGNUM_LARGE_NUMBER_H
+#define RSA_BIGNUM_LARGE_NUMBER_H
+
+#include "rsa_bignum/SmallDigitVector.h"
+#include <vector>
+
+struct LargeNumber
+{
+    SmallDigitVector digits = SmallDigitVector(1, 0);
+    bool is_negative = false;
+    LargeNumber();
+    LargeNumber(const LargeNumber &other);
+    LargeNumber(LargeNumber &&other) noexcept;
+    LargeNumber &operator=(const LargeNumber &other);
+    LargeNumber &operator=(LargeNumber &&other) noexcept;
+};
+
+struct DivisionResult
+{
+    LargeNumber quotient;
+    LargeNumber remainder;
+};
+
+struct DigitDivisionResult
+{
+    std::vector<int> quotient;
+    std::vector<int> remainder;
+};
+
+struct LargeNumberArray
+{
+    LargeNumber result;
+    LargeNumber count;
+};
+
+namespace LargeNumberConversion
+{
+    LargeNumber copyLargeNumber(const LargeNumber &number);
+    LargeNumber addLeadingDigit(const LargeNumber &number, int digit);
+    bool isEqualToZero(const LargeNumber &number);
+    void trimLeadingZeros(LargeNumber &number);
+    std::vector<int> toDigitVector(const LargeNumber &number);
+    LargeNumber fromDigitVector(const std::vector<int> &digits, bool is_negative = false);
+}
+
+#endif
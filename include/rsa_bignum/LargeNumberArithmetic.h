@@ -0,0 +1,73 @@
+#ifndef RSA_BIGNUM_LARGE_NUMBER_ARITHMETIC_H
+#define RSA_BIGNUM_LARGE_NUMBER_ARITHMETIC_H
+
+#include "rsa_bignum/LargeNumber.h"
+#include <cstddef>
+#include <vector>
+
+struct ArithmeticThresholds
+{
+    size_t karatsuba;
+    size_t toomCook;
+    size_t ntt;
+    size_t newtonDivision;
+};
+
+struct NttPrime
+{
+    unsigned long long modulus;
+    unsigned long long generator;
+    unsigned long long inverse;
+    unsigned long long montgomerySquare;
+    unsigned long long halfMontgomery;
+    std::vector<unsigned long long> roots;
+    std::vector<unsigned long long> inverseRoots;
+    NttPrime(unsigned long long modulus, unsigned long long generator);
+    unsigned long long add(unsigned long long first, unsigned long long second) const;
+    unsigned long long subtract(unsigned long long first, unsigned long long second) const;
+    unsigned long long multiply(unsigned long long first, unsigned long long second) const;
+    unsigned long long toMontgomery(unsigned long long value) const;
+    unsigned long long power(unsigned long long base, unsigned long long exponent) const;
+};
+
+namespace LargeNumberArithmetic
+{
+    LargeNumber addLargeNumbers(LargeNumber first, LargeNumber second);
+    LargeNumber subtractLargeNumbers(LargeNumber minuend, LargeNumber subtrahend);
+    LargeNumber multiplyLargeNumbers(LargeNumber first, LargeNumber second);
+    DivisionResult divideByLargeNumber(LargeNumber dividend, LargeNumber divisor);
+    constexpr int DIGIT_BASE = 100;
+    const size_t KARATSUBA_THRESHOLD = 48;
+    const size_t TOOM_COOK_THRESHOLD = 150;
+    const size_t NEWTON_DIVISION_THRESHOLD = 320;
+    const long double CONVOLUTION_LIMIT = 7.2e16L;
+    ArithmeticThresholds &thresholds();
+    long long maximumMagnitude(const std::vector<long long> &coefficients);
+    std::vector<long long> convolveDigits(const std::vector<long long> &first, const std::vector<long long> &second);
+    std::vector<long long> convolveSchoolbook(const std::vector<long long> &first, const std::vector<long long> &second);
+    std::vector<long long> convolveKaratsuba(const std::vector<long long> &first, const std::vector<long long> &second);
+    std::vector<long long> convolveToomCook3(const std::vector<long long> &first, const std::vector<long long> &second);
+    std::vector<int> normalizeDigits(const std::vector<long long> &coefficients);
+    std::vector<int> multiplyDigits(DigitSpan first, DigitSpan second);
+    const size_t NTT_THRESHOLD = 256;
+    const size_t NTT_LIMB_DIGITS = 8;
+    const unsigned long long NTT_LIMB_BASE = 10000000000000000ULL;
+    const size_t NTT_BLOCK_SIZE = 4096;
+    const size_t NTT_PARALLEL_THRESHOLD = 1 << 16;
+    const NttPrime &nttPrime(size_t index);
+    std::vector<unsigned long long> buildNttRoots(const NttPrime &prime, size_t size, bool inverted);
+    void transformForward(std::vector<unsigned long long> &values, const std::vector<unsigned long long> &roots, const NttPrime &prime, bool parallel);
+    void transformInverse(std::vector<unsigned long long> &values, const std::vector<unsigned long long> &roots, const NttPrime &prime, bool parallel);
+    std::vector<int> multiplyDigitsNtt(const std::vector<int> &first, const std::vector<int> &second);
+    std::vector<int> addDigits(const std::vector<int> &first, const std::vector<int> &second);
+    std::vector<int> subtractDigits(const std::vector<int> &minuend, const std::vector<int> &subtrahend);
+    std::vector<int> shiftDigitsLeft(const std::vector<int> &digits, size_t count);
+    std::vector<int> shiftDigitsRight(const std::vector<int> &digits, size_t count);
+    int compareDigits(DigitSpan first, DigitSpan second);
+    std::vector<int> reciprocalDigits(const std::vector<int> &divisor);
+    DigitDivisionResult divideDigitsSchoolbook(DigitSpan dividend, DigitSpan divisor);
+    DigitDivisionResult divideDigitsNewton(const std::vector<int> &dividend, const std::vector<int> &divisor);
+    DigitDivisionResult divideDigits(DigitSpan dividend, DigitSpan divisor);
+}
+
+#endif
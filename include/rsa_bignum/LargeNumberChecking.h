@@ -0,0 +1,11 @@
+#ifndef RSA_BIGNUM_LARGE_NUMBER_CHECKING_H
+#define RSA_BIGNUM_LARGE_NUMBER_CHECKING_H
+
+#include "rsa_bignum/LargeNumber.h"
+
+namespace LargeNumberChecking
+{
+    bool isPrimeNumber(const LargeNumber &number);
+}
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef RSA_BIGNUM_LARGE_NUMBER_SPECIAL_OPERATIONS_H
+#define RSA_BIGNUM_LARGE_NUMBER_SPECIAL_OPERATIONS_H
+
+#include "rsa_bignum/LargeNumber.h"
+#include <vector>
+
+namespace LargeNumberSpecialOperations
+{
+    LargeNumber modularExponentiation(const LargeNumber &base, const LargeNumber &exponent, const LargeNumber &modulus);
+    LargeNumber inverse(LargeNumber number, LargeNumber modulus);
+    std::vector<LargeNumber> batchInverse(const std::vector<LargeNumber> &numbers, const LargeNumber &modulus);
+    LargeNumber reduceModulo(const LargeNumber &number, const LargeNumber &modulus);
+    LargeNumber greatestCommonDivisor(LargeNumber first, LargeNumber second);
+    LargeNumber decryptMultiPrime(const LargeNumber &ciphertext, const std::vector<LargeNumber> &primes, const std::vector<LargeNumber> &exponents, const std::vector<LargeNumber> &coefficients);
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef RSA_BIGNUM_LATENCY_HISTOGRAMS_H
+#define RSA_BIGNUM_LATENCY_HISTOGRAMS_H
+
+#include <ostream>
+
+enum LatencyOperation
+{
+    LATENCY_PRIMALITY_CHECK,
+    LATENCY_BASE_REDUCTION,
+    LATENCY_ENCRYPTION,
+    LATENCY_CIPHERTEXT_MATCH,
+    LATENCY_INVERSE,
+    LATENCY_KEY_GROUP,
+    LATENCY_GREATEST_COMMON_DIVISOR,
+    LATENCY_OPERATION_COUNT
+};
+
+namespace LatencyHistograms
+{
+    inline bool enabled = false;
+    long long now();
+    void record(LatencyOperation operation, long long nanoseconds, unsigned long long count = 1);
+    unsigned long long count(LatencyOperation operation);
+    long long percentile(LatencyOperation operation, double fraction);
+    const char *name(LatencyOperation operation);
+    void print(std::ostream &output);
+    void startReporter(std::ostream &output, unsigned seconds);
+    void stopReporter();
+};
+
+class LatencyTimer
+{
+private:
+    LatencyOperation operation;
+    long long start;
+
+public:
+    LatencyTimer(LatencyOperation operation);
+    ~LatencyTimer();
+    long long elapsed() const;
+    LatencyTimer(const LatencyTimer &) = delete;
+    LatencyTimer &operator=(const LatencyTimer &) = delete;
+};
+
+#endif
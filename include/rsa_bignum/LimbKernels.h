@@ -0,0 +1,48 @@
+#ifndef RSA_BIGNUM_LIMB_KERNELS_H
+#define RSA_BIGNUM_LIMB_KERNELS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct MontgomeryModulus
+{
+    unsigned bits;
+    size_t size;
+    unsigned long long mask;
+    unsigned long long inverse;
+    std::vector<unsigned long long> limbs;
+    std::vector<unsigned long long> montgomeryOne;
+    std::vector<unsigned long long> montgomerySquare;
+};
+
+struct LimbKernelTable
+{
+    const char *name;
+    unsigned long long (*multiplyLimb)(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result);
+    unsigned long long (*addMultiplyLimb)(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result);
+    void (*multiplyComba)(const unsigned long long *first, const unsigned long long *second, size_t size, unsigned long long *result);
+    void (*reduceMontgomery)(unsigned long long *product, const MontgomeryModulus &modulus, unsigned long long *result);
+};
+
+namespace LimbKernels
+{
+    bool supportsMulxAdx();
+    LimbKernelTable portableKernels();
+    LimbKernelTable mulxAdxKernels();
+    LimbKernelTable detectKernels();
+    LimbKernelTable &activeKernels();
+    bool parseKernels(const std::string &name, LimbKernelTable &kernels);
+    unsigned long long readCycleCounter();
+    unsigned long long multiplyLimbPortable(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result);
+    unsigned long long addMultiplyLimbPortable(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result);
+    void multiplyCombaPortable(const unsigned long long *first, const unsigned long long *second, size_t size, unsigned long long *result);
+    void reduceMontgomeryPortable(unsigned long long *product, const MontgomeryModulus &modulus, unsigned long long *result);
+    unsigned long long multiplyLimbMulxAdx(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result);
+    unsigned long long addMultiplyLimbMulxAdx(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result);
+    void multiplyCombaMulxAdx(const unsigned long long *first, const unsigned long long *second, size_t size, unsigned long long *result);
+    void reduceMontgomeryMulxAdx(unsigned long long *product, const MontgomeryModulus &modulus, unsigned long long *result);
+    void subtractModulus(const unsigned long long *value, unsigned long long overflow, const MontgomeryModulus &modulus, unsigned long long *result);
+};
+
+#endif
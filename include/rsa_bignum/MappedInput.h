@@ -0,0 +1,43 @@
+#ifndef RSA_BIGNUM_MAPPED_INPUT_H
+#define RSA_BIGNUM_MAPPED_INPUT_H
+
+#include "rsa_bignum/BinaryFormat.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+class MappedInput
+{
+private:
+    const char *data;
+    size_t size;
+    size_t position;
+    bool mapped;
+    bool binary;
+    bool negative;
+    RecordType type;
+    unsigned long long count;
+    std::string buffer;
+
+public:
+    MappedInput();
+    ~MappedInput();
+    MappedInput(const MappedInput &) = delete;
+    MappedInput &operator=(const MappedInput &) = delete;
+    bool open(const std::string &path);
+    bool isMapped() const;
+    bool isBinary() const;
+    bool isNegative() const;
+    RecordType recordType() const;
+    bool matchesRecordType(RecordType expected) const;
+    unsigned long long recordCount() const;
+    std::string_view contents() const;
+    std::string_view next();
+    bool next(int &value);
+    bool next(std::string_view &token);
+    size_t offset() const;
+    void seek(size_t offset);
+    void discard(size_t end);
+};
+
+#endif
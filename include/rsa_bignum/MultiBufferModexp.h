@@ -0,0 +1,53 @@
+#ifndef RSA_BIGNUM_MULTI_BUFFER_MODEXP_H
+#define RSA_BIGNUM_MULTI_BUFFER_MODEXP_H
+
+#include "rsa_bignum/LargeNumber.h"
+#include "rsa_bignum/LimbKernels.h"
+#include <string>
+#include <vector>
+
+namespace MultiBufferModexp
+{
+    enum class Kernel
+    {
+        Scalar,
+        Avx2,
+        Avx512Ifma
+    };
+    // scratch holds at least (2 * modulus.size + 1) * lanes limbs; exponentiateLanes allocates it once per call.
+    typedef void (*MultiplyKernel)(const unsigned long long *first, const unsigned long long *second, unsigned long long *result, const MontgomeryModulus &modulus, unsigned long long *scratch);
+    const size_t AVX2_LANES = 4;
+    const size_t AVX512_LANES = 8;
+    const unsigned AVX2_LIMB_BITS = 26;
+    const unsigned AVX512_LIMB_BITS = 52;
+    const size_t AVX2_MAX_LIMBS = 1000;
+    const size_t AVX512_MAX_LIMBS = 500;
+    Kernel detectKernel();
+    Kernel &activeKernel();
+    bool parseKernel(const std::string &name, Kernel &kernel);
+    std::vector<int> powerOfTwo(size_t exponent);
+    std::vector<unsigned long long> toBinaryLimbs(const std::vector<int> &digits, unsigned bits, size_t count);
+    std::string binaryLimbsToHex(const std::vector<unsigned long long> &limbs, unsigned bits);
+    MontgomeryModulus buildModulus(const std::vector<int> &modulus, unsigned bits);
+    void montgomeryMultiplyScalar(const unsigned long long *first, const unsigned long long *second, unsigned long long *result, const MontgomeryModulus &modulus, unsigned long long *scratch);
+    void montgomeryMultiplyAvx2(const unsigned long long *first, const unsigned long long *second, unsigned long long *result, const MontgomeryModulus &modulus, unsigned long long *scratch);
+    void montgomeryMultiplyAvx512Ifma(const unsigned long long *first, const unsigned long long *second, unsigned long long *result, const MontgomeryModulus &modulus, unsigned long long *scratch);
+    std::vector<std::string> exponentiateLanes(const std::vector<std::vector<int>> &bases, const std::vector<unsigned long long> &exponent, const MontgomeryModulus &modulus, MultiplyKernel multiply);
+    struct Context
+    {
+        LargeNumber exponent;
+        LargeNumber modulus;
+        std::vector<int> modulusDigits;
+        std::vector<unsigned long long> exponentLimbs;
+        bool montgomery = false;
+        size_t lanes = 1;
+        MontgomeryModulus vectorModulus;
+        MontgomeryModulus scalarModulus;
+        MultiplyKernel multiply = montgomeryMultiplyScalar;
+    };
+    Context prepare(const LargeNumber &exponent, const LargeNumber &modulus);
+    std::vector<std::string> exponentiate(const Context &context, const std::vector<LargeNumber> &bases);
+    std::vector<std::string> exponentiateHex(const std::vector<LargeNumber> &bases, const LargeNumber &exponent, const LargeNumber &modulus);
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef RSA_BIGNUM_NUMBER_STORE_H
+#define RSA_BIGNUM_NUMBER_STORE_H
+
+#include "rsa_bignum/BigInteger.h"
+#include "rsa_bignum/LargeNumber.h"
+#include "rsa_bignum/MappedInput.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+struct NumberStoreHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t limbBits;
+    uint64_t width;
+    uint64_t count;
+    uint64_t limbsOffset;
+    uint64_t indexOffset;
+    uint64_t checksum;
+    uint64_t reserved;
+};
+
+struct NumberStoreEntry
+{
+    uint64_t offset;
+    uint32_t size;
+    uint32_t flags;
+};
+
+struct NumberView
+{
+    const unsigned long long *limbs = nullptr;
+    size_t size = 0;
+    bool negative = false;
+    LargeNumber toLargeNumber() const;
+    BigInteger toBigInteger() const;
+};
+
+class NumberStore
+{
+private:
+    MappedInput file;
+    const NumberStoreHeader *header;
+    const NumberStoreEntry *index;
+    const unsigned long long *limbs;
+
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t FLAG_NEGATIVE = 1;
+    NumberStore();
+    NumberStore(const NumberStore &) = delete;
+    NumberStore &operator=(const NumberStore &) = delete;
+    static bool isStore(std::string_view contents);
+    static uint64_t checksum(const unsigned long long *words, size_t count, uint64_t seed);
+    bool open(const std::string &path);
+    bool verify() const;
+    size_t size() const;
+    size_t width() const;
+    NumberView operator[](size_t position) const;
+    void forEachChunk(size_t chunkSize, const std::function<void(size_t begin, size_t end)> &task) const;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef RSA_BIGNUM_OPERATION_STATS_H
+#define RSA_BIGNUM_OPERATION_STATS_H
+
+#include <ostream>
+
+enum StatCounter
+{
+    STAT_ADD,
+    STAT_SUBTRACT,
+    STAT_MULTIPLY,
+    STAT_DIVIDE,
+    STAT_MODULAR_EXPONENTIATION,
+    STAT_INVERSE,
+    STAT_GREATEST_COMMON_DIVISOR,
+    STAT_MULTIPLY_SCHOOLBOOK,
+    STAT_MULTIPLY_KARATSUBA,
+    STAT_MULTIPLY_TOOM_COOK,
+    STAT_MULTIPLY_NTT,
+    STAT_DIVIDE_SCHOOLBOOK,
+    STAT_DIVIDE_NEWTON,
+    STAT_MONTGOMERY_MULTIPLY,
+    STAT_BIG_INTEGER_ADD,
+    STAT_BIG_INTEGER_SUBTRACT,
+    STAT_BIG_INTEGER_MULTIPLY,
+    STAT_BIG_INTEGER_DIVIDE,
+    STAT_BIG_INTEGER_MODULO,
+    STAT_LARGE_NUMBER_CONSTRUCT,
+    STAT_LARGE_NUMBER_COPY,
+    STAT_LARGE_NUMBER_MOVE,
+    STAT_BIG_INTEGER_CONSTRUCT,
+    STAT_BIG_INTEGER_COPY,
+    STAT_DIGITS_COPIED,
+    STAT_ALLOCATIONS,
+    STAT_ALLOCATED_BYTES,
+    STAT_COUNTER_COUNT
+};
+
+namespace OperationStats
+{
+    inline bool enabled = false;
+    void record(StatCounter counter, unsigned long long amount);
+    inline void count(StatCounter counter, unsigned long long amount = 1)
+    {
+        if (enabled)
+            record(counter, amount);
+    }
+    unsigned long long total(StatCounter counter);
+    const char *name(StatCounter counter);
+    void print(std::ostream &output);
+};
+
+#endif
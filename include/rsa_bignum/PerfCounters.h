@@ -0,0 +1,45 @@
+#ifndef RSA_BIGNUM_PERF_COUNTERS_H
+#define RSA_BIGNUM_PERF_COUNTERS_H
+
+#include <cstddef>
+
+enum PerfEvent
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_PAGE_FAULTS,
+    PERF_EVENT_COUNT
+};
+
+struct PerfReading
+{
+    bool available[PERF_EVENT_COUNT] = {};
+    double values[PERF_EVENT_COUNT] = {};
+};
+
+// The events are opened as one group led by cycles (or by the first event that opens), so
+// they are enabled, disabled and read together and every derived ratio covers the same window.
+class PerfCounters
+{
+private:
+    int descriptors[PERF_EVENT_COUNT];
+    int leader = -1;
+    int members[PERF_EVENT_COUNT];
+    int memberCount = 0;
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+    bool open();
+    bool isOpen() const;
+    void start();
+    PerfReading stop();
+    static const char *name(PerfEvent event);
+};
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef RSA_BIGNUM_PIPELINE_H
+#define RSA_BIGNUM_PIPELINE_H
+
+#include "rsa_bignum/Utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class RingBuffer
+{
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+
+public:
+    explicit RingBuffer(size_t capacity) : mask(0), head(0), tail(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    bool tryPush(T &value)
+    {
+        size_t position = tail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell &cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == position)
+            {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (sequence < position)
+                return false;
+            else
+                position = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPop(T &value)
+    {
+        size_t position = head.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell &cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == position + 1)
+            {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (sequence < position + 1)
+                return false;
+            else
+                position = head.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+namespace Pipeline
+{
+    inline void backoff(unsigned &spins)
+    {
+        if (++spins < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    const size_t MAX_WORKERS = 256;
+
+    inline size_t defaultWorkers()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    template <typename Record, typename Result, typename Read, typename Compute, typename Write>
+    void run(Read read, Compute compute, Write write, size_t workers = 0, size_t capacity = 64)
+    {
+        if (!workers)
+            workers = defaultWorkers();
+        workers = std::min(workers, MAX_WORKERS);
+        const size_t window = 2 * capacity;
+        RingBuffer<std::pair<size_t, Record>> input(capacity);
+        RingBuffer<std::pair<size_t, Result>> output(window);
+        std::atomic<bool> readDone(false), failed(false);
+        std::atomic<size_t> produced(0), written(0);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        auto fail = [&]()
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+            failed.store(true, std::memory_order_release);
+        };
+
+        auto readLoop = [&]()
+        {
+            try
+            {
+                size_t sequence = 0;
+                Record record;
+                while (!failed.load(std::memory_order_acquire) && read(record))
+                {
+                    std::pair<size_t, Record> item(sequence, std::move(record));
+                    unsigned spins = 0;
+                    while (!failed.load(std::memory_order_acquire) && (sequence - written.load(std::memory_order_acquire) >= window || !input.tryPush(item)))
+                        backoff(spins);
+                    ++sequence;
+                    record = Record();
+                }
+                produced.store(sequence, std::memory_order_relaxed);
+            }
+            catch (...)
+            {
+                fail();
+            }
+            readDone.store(true, std::memory_order_release);
+        };
+
+        auto computeLoop = [&]()
+        {
+            Utils::ParallelRegion Region(workers > 1);
+            try
+            {
+                std::pair<size_t, Record> item;
+                unsigned spins = 0;
+                while (!failed.load(std::memory_order_acquire))
+                {
+                    bool finished = readDone.load(std::memory_order_acquire);
+                    if (!input.tryPop(item))
+                    {
+                        if (finished)
+                            return;
+                        backoff(spins);
+                        continue;
+                    }
+                    std::pair<size_t, Result> done(item.first, compute(item.second));
+                    spins = 0;
+                    while (!failed.load(std::memory_order_acquire) && !output.tryPush(done))
+                        backoff(spins);
+                    spins = 0;
+                }
+            }
+            catch (...)
+            {
+                fail();
+            }
+        };
+
+        std::thread reader;
+        std::vector<std::thread> pool;
+        try
+        {
+            reader = std::thread(readLoop);
+            pool.reserve(workers);
+            for (size_t worker = 0; worker < workers; ++worker)
+                pool.emplace_back(computeLoop);
+        }
+        catch (...)
+        {
+            failed.store(true, std::memory_order_release);
+            if (reader.joinable())
+                reader.join();
+            for (std::thread &thread : pool)
+                thread.join();
+            throw;
+        }
+
+        try
+        {
+            std::vector<std::optional<Result>> pending(window);
+            std::pair<size_t, Result> item;
+            size_t next = 0;
+            unsigned spins = 0;
+            while (!failed.load(std::memory_order_acquire))
+            {
+                bool progressed = false;
+                while (output.tryPop(item))
+                {
+                    pending[item.first % window] = std::move(item.second);
+                    progressed = true;
+                }
+                while (pending[next % window])
+                {
+                    write(*pending[next % window]);
+                    pending[next % window].reset();
+                    written.store(++next, std::memory_order_release);
+                    progressed = true;
+                }
+                if (readDone.load(std::memory_order_acquire) && next == produced.load(std::memory_order_relaxed))
+                    break;
+                if (progressed)
+                    spins = 0;
+                else
+                    backoff(spins);
+            }
+        }
+        catch (...)
+        {
+            fail();
+        }
+        reader.join();
+        for (std::thread &thread : pool)
+            thread.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef RSA_BIGNUM_PRIMITIVE_BENCHMARK_H
+#define RSA_BIGNUM_PRIMITIVE_BENCHMARK_H
+
+#include "rsa_bignum/PerfCounters.h"
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct PrimitiveResult
+{
+    std::string primitive;
+    size_t bits;
+    size_t iterations;
+    std::vector<double> samples;
+    double meanNs;
+    double medianNs;
+    double minimumNs;
+    double deviationNs;
+    double operationsPerSecond;
+    PerfReading counters;
+};
+
+struct PrimitiveOptions
+{
+    std::vector<size_t> bits = {256, 512, 1024, 2048, 4096};
+    size_t repetitions = 10;
+    double minimumTimeMs = 20;
+    std::string filter;
+    bool counters = false;
+};
+
+namespace PrimitiveBenchmark
+{
+    const unsigned long long SEED = 20240229;
+    std::string randomHex(std::mt19937_64 &generator, size_t bits, bool odd);
+    std::string primeHex(std::mt19937_64 &generator, size_t bits);
+    PrimitiveResult measure(const std::string &primitive, size_t bits, const PrimitiveOptions &options, const std::function<void(size_t)> &operation, PerfCounters *counters);
+    bool derivedCounter(const PerfReading &reading, const std::string &metric, double &value);
+    std::vector<PrimitiveResult> run(const PrimitiveOptions &options, std::ostream &log);
+    void writeJson(const std::vector<PrimitiveResult> &results, const PrimitiveOptions &options, std::ostream &output);
+    std::string escapeJson(const std::string &value);
+};
+
+#endif
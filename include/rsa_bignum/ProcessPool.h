@@ -0,0 +1,22 @@
+#ifndef RSA_BIGNUM_PROCESS_POOL_H
+#define RSA_BIGNUM_PROCESS_POOL_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct ProcessJobResult
+{
+    bool succeeded = false;
+    double seconds = 0;
+    std::string error;
+};
+
+namespace ProcessPool
+{
+    std::vector<std::vector<int>> numaNodes();
+    std::vector<ProcessJobResult> run(size_t jobCount, const std::function<void(size_t)> &job, size_t processes, bool pinNuma);
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef RSA_BIGNUM_SERVER_PROTOCOL_H
+#define RSA_BIGNUM_SERVER_PROTOCOL_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum ServerOperation
+{
+    SERVER_IS_PRIME = 1,
+    SERVER_DERIVE_KEY = 2,
+    SERVER_ENCRYPT_BATCH = 3
+};
+
+enum ServerStatus
+{
+    SERVER_OK = 0,
+    SERVER_ERROR = 1
+};
+
+struct ProtocolRecord
+{
+    std::string_view magnitude;
+    bool negative = false;
+};
+
+namespace ServerProtocol
+{
+    const size_t MAX_FRAME_BYTES = 256u << 20;
+    const unsigned char FLAG_CARMICHAEL = 1;
+    int listenOn(const std::string &path);
+    int connectTo(const std::string &path);
+    bool readFrame(int descriptor, std::string &payload);
+    bool writeFrame(int descriptor, std::string_view payload);
+    bool parseRecords(std::string_view payload, size_t offset, std::vector<ProtocolRecord> &records);
+};
+
+#endif
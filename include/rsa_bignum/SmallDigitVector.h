@@ -0,0 +1,61 @@
+#ifndef RSA_BIGNUM_SMALL_DIGIT_VECTOR_H
+#define RSA_BIGNUM_SMALL_DIGIT_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+class SmallDigitVector
+{
+public:
+    static const size_t INLINE_CAPACITY = 320;
+    SmallDigitVector(size_t count = 0, int value = 0);
+    SmallDigitVector(const std::vector<int> &values);
+    SmallDigitVector(const SmallDigitVector &other);
+    SmallDigitVector(SmallDigitVector &&other) noexcept;
+    SmallDigitVector &operator=(const SmallDigitVector &other);
+    SmallDigitVector &operator=(SmallDigitVector &&other) noexcept;
+    size_t size() const;
+    bool empty() const;
+    int *begin();
+    int *end();
+    const int *begin() const;
+    const int *end() const;
+    int &operator[](size_t index);
+    const int &operator[](size_t index) const;
+    int &back();
+    const int &back() const;
+    void resize(size_t count, int value = 0);
+    void push_back(int value);
+    void pop_back();
+    std::vector<int> toVector() const;
+
+private:
+    size_t length = 0;
+    int inlineDigits[INLINE_CAPACITY];
+    std::vector<int> heapDigits;
+    int *data();
+    const int *data() const;
+};
+
+// Read-only view of base-100 digits, least significant first, so the arithmetic kernels can read
+// SmallDigitVector and std::vector storage alike without copying one into the other.
+struct DigitSpan
+{
+    const int *digits = nullptr;
+    size_t length = 0;
+    DigitSpan() = default;
+    DigitSpan(const int *digits, size_t length) : digits(digits), length(length) {}
+    DigitSpan(const std::vector<int> &values) : digits(values.data()), length(values.size()) {}
+    DigitSpan(const SmallDigitVector &values) : digits(values.begin()), length(values.size()) {}
+    // A braced list would otherwise bind through SmallDigitVector(count, value) and view zeros.
+    DigitSpan(std::initializer_list<int> values) = delete;
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    const int *begin() const { return digits; }
+    const int *end() const { return digits + length; }
+    const int &operator[](size_t index) const { return digits[index]; }
+    const int &back() const { return digits[length - 1]; }
+};
+
+#endif
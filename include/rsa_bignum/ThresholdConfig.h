@@ -0,0 +1,19 @@
+#ifndef RSA_BIGNUM_THRESHOLD_CONFIG_H
+#define RSA_BIGNUM_THRESHOLD_CONFIG_H
+
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include <cstddef>
+#include <string>
+
+namespace ThresholdConfig
+{
+    const char *const DEFAULT_PATH = "rsa_thresholds.conf";
+    const size_t MINIMUM_THRESHOLD = 8;
+    const size_t MAXIMUM_THRESHOLD = (size_t)1 << 40;
+    std::string configPath();
+    ArithmeticThresholds defaults();
+    ArithmeticThresholds load(const std::string &path);
+    bool save(const ArithmeticThresholds &thresholds, const std::string &path);
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef RSA_BIGNUM_TRACE_H
+#define RSA_BIGNUM_TRACE_H
+
+#include <string>
+
+namespace Trace
+{
+    inline bool enabled = false;
+    void enable();
+    double now();
+    void record(const char *name, const char *category, double start, double duration, long long index);
+    bool write(const std::string &path);
+    std::string escape(const char *value);
+};
+
+class TraceSpan
+{
+private:
+    const char *name;
+    const char *category;
+    long long index;
+    double start;
+
+public:
+    TraceSpan(const char *name, const char *category, long long index = -1);
+    ~TraceSpan();
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef RSA_BIGNUM_UTILS_H
+#define RSA_BIGNUM_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Utils
+{
+    int findIndex(const std::vector<std::string> &vec, const std::string &target);
+    int findIndex(const std::vector<std::string_view> &vec, std::string_view target);
+    void parallelFor(size_t count, const std::function<void(size_t)> &task, size_t workers = 0);
+    bool parseCount(std::string_view text, size_t &value, size_t maximum = SIZE_MAX);
+
+    // Marks the calling thread as one worker of a parallel region for its lifetime. parallelFor runs
+    // serially inside a region, so an NTT inside a BatchGcd or Pipeline worker does not spawn
+    // another hardware_concurrency threads for every butterfly stage.
+    class ParallelRegion
+    {
+    public:
+        explicit ParallelRegion(bool active = true);
+        ~ParallelRegion();
+        ParallelRegion(const ParallelRegion &) = delete;
+        ParallelRegion &operator=(const ParallelRegion &) = delete;
+        static bool inside();
+
+    private:
+        bool previous;
+    };
+};
+
+#endif
@@ -0,0 +1,110 @@
+#include "rsa_bignum/Benchmark.h"
+#include "rsa_bignum/LimbKernels.h"
+#include "rsa_bignum/PrimitiveBenchmark.h"
+#include "rsa_bignum/ThresholdConfig.h"
+#include "rsa_bignum/Utils.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace CommandLine
+{
+    bool parseBits(const std::string &list, std::vector<size_t> &bits);
+    int runDeveloperMode(int argc, char **argv);
+};
+
+int main(int argc, char **argv)
+{
+    int status = argc == 2 || argc == 3 ? CommandLine::runDeveloperMode(argc, argv) : -1;
+    if (status >= 0)
+        return status;
+    PrimitiveOptions options;
+    std::string jsonPath;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (option == "--bits" && hasValue && CommandLine::parseBits(argv[i + 1], options.bits))
+            ++i;
+        else if (option == "--repetitions" && hasValue)
+            options.repetitions = std::stoul(argv[++i]);
+        else if (option == "--min-time-ms" && hasValue)
+            options.minimumTimeMs = std::stod(argv[++i]);
+        else if (option == "--filter" && hasValue)
+            options.filter = argv[++i];
+        else if (option == "--counters")
+            options.counters = true;
+        else if (option == "--json" && hasValue)
+            jsonPath = argv[++i];
+        else if (option == "--limb-kernel" && hasValue && LimbKernels::parseKernels(argv[i + 1], LimbKernels::activeKernels()))
+            ++i;
+        else
+        {
+            std::cerr << "Usage: rsa_bench [--bits 256,512,...] [--repetitions N] [--min-time-ms MS] [--filter NAME] [--json FILE] [--counters] [--limb-kernel portable|mulx-adx]"
+                      << " | --sweep-multiplication [max_bits] | --bench-limb-kernels | --tune [config_file] | --compare-backends [count]" << std::endl;
+            return 1;
+        }
+    }
+    std::vector<PrimitiveResult> results = PrimitiveBenchmark::run(options, std::cout);
+    if (!jsonPath.empty())
+    {
+        std::ofstream output(jsonPath);
+        if (!output.is_open())
+        {
+            std::cerr << "Failed to open " << jsonPath << std::endl;
+            return 1;
+        }
+        PrimitiveBenchmark::writeJson(results, options, output);
+    }
+    return 0;
+}
+
+// Returns the exit status of a developer mode, or -1 when argv[1] is not one.
+int CommandLine::runDeveloperMode(int argc, char **argv)
+{
+    const std::string mode = argv[1];
+    size_t count = 0;
+    if (mode == "--sweep-multiplication" && (argc == 2 || Utils::parseCount(argv[2], count)))
+    {
+        Benchmark::sweepMultiplication(std::cout, argc > 2 ? count : 32768);
+        return 0;
+    }
+    if (mode == "--compare-backends" && (argc == 2 || Utils::parseCount(argv[2], count)))
+        return Benchmark::compareBackends(std::cout, argc > 2 ? count : 1000) ? 0 : 1;
+    if (mode == "--tune")
+    {
+        std::string path = argc > 2 ? argv[2] : ThresholdConfig::configPath();
+        if (!ThresholdConfig::save(Benchmark::tuneThresholds(std::cout), path))
+        {
+            std::cerr << "Failed to write threshold file " << path << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote " << path << std::endl;
+        return 0;
+    }
+    if (mode == "--bench-limb-kernels" && argc == 2)
+    {
+        Benchmark::measureLimbKernels(std::cout);
+        return 0;
+    }
+    return -1;
+}
+
+bool CommandLine::parseBits(const std::string &list, std::vector<size_t> &bits)
+{
+    std::vector<size_t> parsed;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (item.empty() || item.find_first_not_of("0123456789") != std::string::npos || std::stoul(item) < 8)
+            return false;
+        parsed.push_back(std::stoul(item));
+    }
+    if (parsed.empty())
+        return false;
+    bits = parsed;
+    return true;
+}
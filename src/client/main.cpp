@@ -0,0 +1,88 @@
+#include "rsa_bignum/BinaryFormat.h"
+#include "rsa_bignum/ServerProtocol.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace CommandLine
+{
+    bool buildRequest(const std::string &command, int first, int argc, char **argv, std::string &request);
+    void printResponse(const std::string &command, const std::vector<ProtocolRecord> &records);
+};
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        std::cerr << "Usage: rsa_client <socket_path> is-prime HEX... | derive-key [--lambda] PRIME... E | encrypt N E MESSAGE..." << std::endl;
+        return 1;
+    }
+    const std::string command = argv[2];
+    std::string request, response;
+    try
+    {
+        if (!CommandLine::buildRequest(command, 3, argc, argv, request))
+        {
+            std::cerr << "Unknown command " << command << std::endl;
+            return 1;
+        }
+    }
+    catch (const char *message)
+    {
+        std::cerr << message << std::endl;
+        return 1;
+    }
+    int connection = ServerProtocol::connectTo(argv[1]);
+    if (connection < 0)
+    {
+        std::cerr << "Failed to connect to " << argv[1] << std::endl;
+        return 1;
+    }
+    bool exchanged = ServerProtocol::writeFrame(connection, request) && ServerProtocol::readFrame(connection, response);
+    close(connection);
+    std::vector<ProtocolRecord> records;
+    if (!exchanged || response.empty())
+    {
+        std::cerr << "No response from server" << std::endl;
+        return 1;
+    }
+    if (response[0] != SERVER_OK || !ServerProtocol::parseRecords(response, 1, records))
+    {
+        std::cerr << "Server error: " << response.substr(1) << std::endl;
+        return 1;
+    }
+    CommandLine::printResponse(command, records);
+    return 0;
+}
+
+bool CommandLine::buildRequest(const std::string &command, int first, int argc, char **argv, std::string &request)
+{
+    unsigned char flags = 0;
+    if (command == "is-prime")
+        request.push_back(char(SERVER_IS_PRIME));
+    else if (command == "derive-key")
+        request.push_back(char(SERVER_DERIVE_KEY));
+    else if (command == "encrypt")
+        request.push_back(char(SERVER_ENCRYPT_BATCH));
+    else
+        return false;
+    if (command == "derive-key" && first < argc && std::string(argv[first]) == "--lambda")
+    {
+        flags |= ServerProtocol::FLAG_CARMICHAEL;
+        ++first;
+    }
+    request.push_back(char(flags));
+    for (int i = first; i < argc; ++i)
+        BinaryFormat::appendHex(request, argv[i]);
+    return true;
+}
+
+void CommandLine::printResponse(const std::string &command, const std::vector<ProtocolRecord> &records)
+{
+    for (const ProtocolRecord &record : records)
+        if (command == "is-prime" || record.negative)
+            std::cout << BinaryFormat::toInteger(record.magnitude, record.negative) << std::endl;
+        else
+            std::cout << BinaryFormat::toHex(record.magnitude) << std::endl;
+}
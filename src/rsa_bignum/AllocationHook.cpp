@@ -0,0 +1,28 @@
+#include "rsa_bignum/OperationStats.h"
+#include <cstdlib>
+#include <new>
+
+void *operator new(std::size_t size)
+{
+    OperationStats::count(STAT_ALLOCATIONS);
+    OperationStats::count(STAT_ALLOCATED_BYTES, size);
+    while (true)
+    {
+        if (void *pointer = std::malloc(size ? size : 1))
+            return pointer;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
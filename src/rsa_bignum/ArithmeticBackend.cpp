@@ -0,0 +1,137 @@
+#include "rsa_bignum/ArithmeticBackend.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include <string>
+
+const char *NativeBackend::name()
+{
+    return "native";
+}
+
+std::vector<int> NativeBackend::multiply(DigitSpan first, DigitSpan second)
+{
+    std::vector<int> Result = LargeNumberArithmetic::multiplyDigits(first, second);
+    while (!Result.empty() && Result.back() == 0)
+        Result.pop_back();
+    return Result;
+}
+
+DigitDivisionResult NativeBackend::divide(DigitSpan dividend, DigitSpan divisor)
+{
+    return LargeNumberArithmetic::divideDigits(dividend, divisor);
+}
+
+std::vector<int> NativeBackend::powerModulo(const std::vector<int> &base, const std::vector<int> &exponent, const std::vector<int> &modulus)
+{
+    const std::vector<int> One = {1}, Two = {2};
+    std::vector<int> Result = divide(One, modulus).remainder, Base = divide(base, modulus).remainder, Exponent = exponent;
+    while (!Exponent.empty() && Exponent.back() == 0)
+        Exponent.pop_back();
+    while (!Exponent.empty())
+    {
+        if (Exponent[0] % 2 == 1)
+            Result = divide(multiply(Result, Base), modulus).remainder;
+        Exponent = divide(Exponent, Two).quotient;
+        if (!Exponent.empty())
+            Base = divide(multiply(Base, Base), modulus).remainder;
+    }
+    return Result;
+}
+
+#if defined(RSA_USE_GMP)
+const char *GmpBackend::name()
+{
+    return "gmp";
+}
+
+void GmpBackend::toInteger(mpz_t result, DigitSpan digits)
+{
+    std::string decimal = "0";
+    for (size_t i = digits.size(); i-- > 0;)
+    {
+        decimal.push_back('0' + digits[i] / 10);
+        decimal.push_back('0' + digits[i] % 10);
+    }
+    mpz_set_str(result, decimal.c_str(), 10);
+}
+
+std::vector<int> GmpBackend::fromInteger(const mpz_t value)
+{
+    std::string decimal(mpz_sizeinbase(value, 10) + 2, '\0');
+    mpz_get_str(&decimal[0], 10, value);
+    decimal.resize(decimal.find('\0'));
+    std::vector<int> Result;
+    for (size_t end = decimal.size(); end > 0;)
+    {
+        size_t start = end >= 2 ? end - 2 : 0;
+        int digit = 0;
+        for (size_t i = start; i < end; i++)
+            digit = digit * 10 + (decimal[i] - '0');
+        Result.push_back(digit);
+        end = start;
+    }
+    while (!Result.empty() && Result.back() == 0)
+        Result.pop_back();
+    return Result;
+}
+
+std::vector<int> GmpBackend::multiply(DigitSpan first, DigitSpan second)
+{
+    mpz_t First, Second;
+    mpz_init(First);
+    mpz_init(Second);
+    toInteger(First, first);
+    toInteger(Second, second);
+    mpz_mul(First, First, Second);
+    std::vector<int> Result = fromInteger(First);
+    mpz_clear(First);
+    mpz_clear(Second);
+    return Result;
+}
+
+DigitDivisionResult GmpBackend::divide(DigitSpan dividend, DigitSpan divisor)
+{
+    mpz_t Dividend, Divisor, Quotient, Remainder;
+    mpz_init(Divisor);
+    toInteger(Divisor, divisor);
+    if (mpz_sgn(Divisor) == 0)
+    {
+        mpz_clear(Divisor);
+        throw("Arithmetic Error: Division By 0");
+    }
+    mpz_init(Dividend);
+    mpz_init(Quotient);
+    mpz_init(Remainder);
+    toInteger(Dividend, dividend);
+    mpz_tdiv_qr(Quotient, Remainder, Dividend, Divisor);
+    DigitDivisionResult Result;
+    Result.quotient = fromInteger(Quotient);
+    Result.remainder = fromInteger(Remainder);
+    mpz_clear(Dividend);
+    mpz_clear(Divisor);
+    mpz_clear(Quotient);
+    mpz_clear(Remainder);
+    return Result;
+}
+
+std::vector<int> GmpBackend::powerModulo(const std::vector<int> &base, const std::vector<int> &exponent, const std::vector<int> &modulus)
+{
+    mpz_t Base, Exponent, Modulus;
+    mpz_init(Modulus);
+    toInteger(Modulus, modulus);
+    if (mpz_sgn(Modulus) == 0)
+    {
+        mpz_clear(Modulus);
+        throw("Arithmetic Error: Division By 0");
+    }
+    mpz_init(Base);
+    mpz_init(Exponent);
+    toInteger(Base, base);
+    toInteger(Exponent, exponent);
+    mpz_powm(Base, Base, Exponent, Modulus);
+    std::vector<int> Result = fromInteger(Base);
+    mpz_clear(Base);
+    mpz_clear(Exponent);
+    mpz_clear(Modulus);
+    return Result;
+}
+#endif
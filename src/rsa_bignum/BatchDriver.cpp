@@ -0,0 +1,166 @@
+#include "rsa_bignum/BatchDriver.h"
+#include "rsa_bignum/ProcessPool.h"
+#include "rsa_bignum/Trace.h"
+#include "rsa_bignum/Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<size_t> files;
+    };
+
+    bool takeFile(std::vector<WorkQueue> &queues, size_t self, size_t &file)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queues[self].mutex);
+            if (!queues[self].files.empty())
+            {
+                file = queues[self].files.front();
+                queues[self].files.pop_front();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues.size(); ++offset)
+        {
+            WorkQueue &victim = queues[(self + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.files.empty())
+            {
+                file = victim.files.back();
+                victim.files.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void runThreads(std::vector<BatchFileResult> &files, const std::function<void(size_t)> &runFile, size_t threads)
+    {
+        if (!threads)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = std::max<size_t>(1, std::min(threads, files.size()));
+        std::vector<WorkQueue> queues(threads);
+        for (size_t i = 0; i < files.size(); ++i)
+            queues[i % threads].files.push_back(i);
+
+        auto worker = [&](size_t self)
+        {
+            Utils::ParallelRegion Region(threads > 1);
+            size_t file;
+            while (takeFile(queues, self, file))
+            {
+                BatchFileResult &current = files[file];
+                TraceSpan Span("batchFile", "io", file);
+                auto start = std::chrono::steady_clock::now();
+                try
+                {
+                    runFile(file);
+                    current.succeeded = true;
+                }
+                catch (const char *message)
+                {
+                    current.error = message;
+                }
+                catch (const std::exception &exception)
+                {
+                    current.error = exception.what();
+                }
+                catch (...)
+                {
+                    current.error = "unknown exception";
+                }
+                current.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t self = 1; self < threads; ++self)
+            pool.emplace_back(worker, self);
+        worker(0);
+        for (std::thread &thread : pool)
+            thread.join();
+    }
+}
+
+std::vector<BatchFileResult> BatchDriver::run(const std::string &inputDirectory, const std::string &outputDirectory, const FileTask &task, const BatchOptions &options)
+{
+    std::error_code error;
+    if (!std::filesystem::is_directory(inputDirectory, error))
+        throw("Batch Error: input path is not a directory");
+    std::filesystem::create_directories(outputDirectory, error);
+    if (!std::filesystem::is_directory(outputDirectory, error))
+        throw("Batch Error: cannot create output directory");
+
+    std::vector<BatchFileResult> Result;
+    for (const auto &entry : std::filesystem::directory_iterator(inputDirectory, error))
+        if (entry.is_regular_file(error))
+        {
+            BatchFileResult file;
+            file.name = entry.path().filename().string();
+            file.bytes = entry.file_size(error);
+            Result.push_back(file);
+        }
+    std::sort(Result.begin(), Result.end(), [](const BatchFileResult &left, const BatchFileResult &right)
+    {
+        return left.bytes != right.bytes ? left.bytes > right.bytes : left.name < right.name;
+    });
+
+    auto runFile = [&](size_t file)
+    {
+        task((std::filesystem::path(inputDirectory) / Result[file].name).string(), (std::filesystem::path(outputDirectory) / Result[file].name).string());
+    };
+    if (options.processes)
+    {
+        std::vector<ProcessJobResult> jobs = ProcessPool::run(Result.size(), runFile, options.processes, options.pinNuma);
+        for (size_t file = 0; file < Result.size(); ++file)
+        {
+            Result[file].succeeded = jobs[file].succeeded;
+            Result[file].seconds = jobs[file].seconds;
+            Result[file].error = jobs[file].error;
+        }
+    }
+    else
+        runThreads(Result, runFile, options.threads);
+
+    std::sort(Result.begin(), Result.end(), [](const BatchFileResult &left, const BatchFileResult &right)
+    {
+        return left.name < right.name;
+    });
+    return Result;
+}
+
+void BatchDriver::printSummary(std::ostream &os, const std::vector<BatchFileResult> &results, double wallSeconds)
+{
+    size_t width = 4, failed = 0;
+    double busySeconds = 0;
+    for (const BatchFileResult &file : results)
+        width = std::max(width, file.name.size());
+    os << std::left << std::setw(width) << "file" << std::right << std::setw(14) << "bytes" << std::setw(12) << "ms" << "  status" << '\n';
+    for (const BatchFileResult &file : results)
+    {
+        os << std::left << std::setw(width) << file.name << std::right << std::setw(14) << file.bytes
+           << std::setw(12) << std::fixed << std::setprecision(3) << file.seconds * 1e3
+           << "  " << (file.succeeded ? "ok" : "FAILED: " + file.error) << '\n';
+        busySeconds += file.seconds;
+        failed += !file.succeeded;
+    }
+    os << results.size() << " files, " << failed << " failed, " << std::fixed << std::setprecision(3)
+       << busySeconds * 1e3 << " ms of file time in " << wallSeconds * 1e3 << " ms wall" << std::endl;
+}
+
+bool BatchDriver::processDirectory(const std::string &inputDirectory, const std::string &outputDirectory, const FileTask &task, const BatchOptions &options, std::ostream &summary)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<BatchFileResult> results = run(inputDirectory, outputDirectory, task, options);
+    printSummary(summary, results, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return std::all_of(results.begin(), results.end(), [](const BatchFileResult &file) { return file.succeeded; });
+}
@@ -0,0 +1,85 @@
+#include "rsa_bignum/BatchGcd.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include "rsa_bignum/LargeNumberSpecialOperations.h"
+#include "rsa_bignum/LatencyHistograms.h"
+#include "rsa_bignum/Trace.h"
+#include "rsa_bignum/Utils.h"
+#include <algorithm>
+
+namespace
+{
+    bool sameMagnitude(const LargeNumber &first, const LargeNumber &second)
+    {
+        return LargeNumberArithmetic::compareDigits(first.digits, second.digits) == 0;
+    }
+}
+
+std::vector<std::vector<LargeNumber>> BatchGcd::buildProductTree(const std::vector<LargeNumber> &moduli)
+{
+    TraceSpan Span("BatchGcd::buildProductTree", "arithmetic");
+    std::vector<std::vector<LargeNumber>> productTree(1, moduli);
+    while (productTree.back().size() > 1)
+    {
+        const std::vector<LargeNumber> &level = productTree.back();
+        std::vector<LargeNumber> next((level.size() + 1) / 2);
+        Utils::parallelFor(next.size(), [&](size_t i)
+        {
+            TraceSpan Span("productTreeNode", "message", i);
+            next[i] = 2 * i + 1 < level.size() ? LargeNumberArithmetic::multiplyLargeNumbers(level[2 * i], level[2 * i + 1]) : level[2 * i];
+        });
+        productTree.push_back(std::move(next));
+    }
+    return productTree;
+}
+
+std::vector<LargeNumber> BatchGcd::computeRemainders(const std::vector<std::vector<LargeNumber>> &productTree)
+{
+    TraceSpan Span("BatchGcd::computeRemainders", "arithmetic");
+    std::vector<LargeNumber> remainders = productTree.back();
+    for (size_t level = productTree.size() - 1; level-- > 0;)
+    {
+        const std::vector<LargeNumber> &nodes = productTree[level];
+        std::vector<LargeNumber> next(nodes.size());
+        Utils::parallelFor(nodes.size(), [&](size_t i)
+        {
+            TraceSpan Span("remainderTreeNode", "message", i);
+            next[i] = LargeNumberSpecialOperations::reduceModulo(remainders[i / 2], LargeNumberArithmetic::multiplyLargeNumbers(nodes[i], nodes[i]));
+        });
+        remainders = std::move(next);
+    }
+    return remainders;
+}
+
+std::vector<LargeNumber> BatchGcd::findSharedFactors(const std::vector<LargeNumber> &moduli)
+{
+    TraceSpan Span("BatchGcd::findSharedFactors", "arithmetic");
+    LargeNumber One;
+    One.digits[0] = 1;
+    std::vector<LargeNumber> factors(moduli.size(), One);
+    if (moduli.empty())
+        return factors;
+    std::vector<LargeNumber> remainders = computeRemainders(buildProductTree(moduli));
+    Utils::parallelFor(moduli.size(), [&](size_t i)
+    {
+        TraceSpan Span("greatestCommonDivisor", "message", i);
+        LatencyTimer Latency(LATENCY_GREATEST_COMMON_DIVISOR);
+        factors[i] = LargeNumberSpecialOperations::greatestCommonDivisor(LargeNumberArithmetic::divideByLargeNumber(remainders[i], moduli[i]).quotient, moduli[i]);
+    });
+    std::vector<size_t> whole;
+    for (size_t i = 0; i < moduli.size(); ++i)
+        if (sameMagnitude(factors[i], moduli[i]))
+            whole.push_back(i);
+    for (size_t i : whole)
+        for (size_t j = 0; j < moduli.size(); ++j)
+        {
+            if (j == i || sameMagnitude(factors[j], One))
+                continue;
+            LargeNumber Divisor = LargeNumberSpecialOperations::greatestCommonDivisor(moduli[i], moduli[j]);
+            if (!sameMagnitude(Divisor, moduli[i]) && !sameMagnitude(Divisor, One))
+            {
+                factors[i] = Divisor;
+                break;
+            }
+        }
+    return factors;
+}
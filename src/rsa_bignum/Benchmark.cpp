@@ -0,0 +1,245 @@
+#include "rsa_bignum/Benchmark.h"
+#include "rsa_bignum/ArithmeticBackend.h"
+#include "rsa_bignum/LimbKernels.h"
+#include "rsa_bignum/ThresholdConfig.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+double Benchmark::measureOperation(const std::function<void()> &operation)
+{
+    size_t iterations = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::micro> elapsed(0);
+    while (elapsed.count() < 20000 || iterations < 3)
+    {
+        operation();
+        ++iterations;
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+    return elapsed.count() / iterations;
+}
+
+void Benchmark::sweepMultiplication(std::ostream &output, size_t maxBits)
+{
+    std::mt19937_64 generator(20240229);
+    std::uniform_int_distribution<int> digit(0, LargeNumberArithmetic::DIGIT_BASE - 1);
+    output << "bits digits schoolbook_us karatsuba_us toom3_us ntt_us best";
+#if defined(RSA_USE_GMP)
+    output << " gmp_us";
+#endif
+    output << std::endl;
+    for (size_t bits = 256; bits <= maxBits; bits += bits / 4)
+    {
+        size_t digits = bits * 3 / 20;
+        std::vector<int> first(digits), second(digits);
+        for (size_t i = 0; i < digits; ++i)
+        {
+            first[i] = digit(generator);
+            second[i] = digit(generator);
+        }
+        first.back() = second.back() = 1;
+        std::vector<long long> firstCoefficients(first.begin(), first.end()), secondCoefficients(second.begin(), second.end());
+        volatile size_t sink = 0;
+        std::vector<std::pair<std::string, double>> timings;
+        if (digits <= 20000)
+            timings.emplace_back("schoolbook", measureOperation([&]() { sink = sink + LargeNumberArithmetic::convolveSchoolbook(firstCoefficients, secondCoefficients).size(); }));
+        timings.emplace_back("karatsuba", measureOperation([&]() { sink = sink + LargeNumberArithmetic::convolveKaratsuba(firstCoefficients, secondCoefficients).size(); }));
+        timings.emplace_back("toom3", measureOperation([&]() { sink = sink + LargeNumberArithmetic::convolveToomCook3(firstCoefficients, secondCoefficients).size(); }));
+        timings.emplace_back("ntt", measureOperation([&]() { sink = sink + LargeNumberArithmetic::multiplyDigitsNtt(first, second).size(); }));
+        output << bits << ' ' << digits << ' ';
+        if (digits > 20000)
+            output << "- ";
+        for (const auto &timing : timings)
+            output << timing.second << ' ';
+        output << std::min_element(timings.begin(), timings.end(), [](const std::pair<std::string, double> &a, const std::pair<std::string, double> &b) { return a.second < b.second; })->first;
+#if defined(RSA_USE_GMP)
+        output << ' ' << measureOperation([&]() { sink = sink + GmpBackend::multiply(first, second).size(); });
+#endif
+        output << std::endl;
+    }
+}
+
+
+double Benchmark::measureCycles(const std::function<void(size_t)> &operation, size_t repetitions)
+{
+    double best = 0;
+    for (int round = 0; round < 7; ++round)
+    {
+        unsigned long long start = LimbKernels::readCycleCounter();
+        operation(repetitions);
+        double cycles = double(LimbKernels::readCycleCounter() - start) / repetitions;
+        if (round == 0 || cycles < best)
+            best = cycles;
+    }
+    return best;
+}
+
+void Benchmark::measureLimbKernels(std::ostream &output)
+{
+    std::mt19937_64 generator(20240229);
+    std::vector<LimbKernelTable> tables = {LimbKernels::portableKernels()};
+    if (LimbKernels::supportsMulxAdx())
+        tables.push_back(LimbKernels::mulxAdxKernels());
+    output << "kernel limbs mul_1 addmul_1 comba redc (cycles per limb; comba and redc per limb product)" << std::endl;
+    for (size_t size = 4; size <= 64; size *= 2)
+    {
+        MontgomeryModulus modulus;
+        modulus.size = size;
+        for (size_t i = 0; i < size; ++i)
+            modulus.limbs.push_back(generator());
+        modulus.limbs[0] |= 1;
+        modulus.limbs.back() |= 1ULL << 63;
+        unsigned long long inverse = modulus.limbs[0];
+        for (int i = 0; i < 6; i++)
+            inverse *= 2 - modulus.limbs[0] * inverse;
+        modulus.inverse = 0 - inverse;
+        std::vector<unsigned long long> first(size), second(size), product(2 * size), scratch(2 * size), result(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            first[i] = generator();
+            second[i] = generator();
+        }
+        for (const auto &table : tables)
+        {
+            volatile unsigned long long sink = 0;
+            double multiply = measureCycles([&](size_t repetitions) {
+                for (size_t r = 0; r < repetitions; ++r)
+                    sink = sink + table.multiplyLimb(first.data(), size, second[r % size], result.data());
+            }, 20000) / size;
+            double addMultiply = measureCycles([&](size_t repetitions) {
+                for (size_t r = 0; r < repetitions; ++r)
+                    sink = sink + table.addMultiplyLimb(first.data(), size, second[r % size], product.data());
+            }, 20000) / size;
+            double comba = measureCycles([&](size_t repetitions) {
+                for (size_t r = 0; r < repetitions; ++r)
+                    table.multiplyComba(first.data(), second.data(), size, product.data());
+            }, 2000) / (size * size);
+            double reduce = measureCycles([&](size_t repetitions) {
+                for (size_t r = 0; r < repetitions; ++r)
+                {
+                    std::copy(product.begin(), product.end(), scratch.begin());
+                    table.reduceMontgomery(scratch.data(), modulus, result.data());
+                }
+            }, 2000) / (size * size);
+            output << table.name << ' ' << size << ' ' << multiply << ' ' << addMultiply << ' ' << comba << ' ' << reduce << std::endl;
+        }
+    }
+}
+
+size_t Benchmark::findCrossover(std::ostream &log, const std::string &tier, size_t &threshold, size_t first, size_t last, const std::function<std::function<void()>(size_t)> &prepare)
+{
+    size_t candidate = 0, wins = 0, original = threshold;
+    for (size_t size = first; size <= last; size += std::max<size_t>(1, size / 8))
+    {
+        std::function<void()> operation = prepare(size);
+        threshold = ThresholdConfig::MAXIMUM_THRESHOLD;
+        double without = measureOperation(operation);
+        threshold = size;
+        double with = measureOperation(operation);
+        log << tier << ' ' << size << ' ' << without << ' ' << with << std::endl;
+        if (with >= without)
+            wins = 0;
+        else if (wins++ == 0)
+            candidate = size;
+        if (wins == 2)
+        {
+            threshold = candidate;
+            return threshold;
+        }
+    }
+    threshold = original;
+    log << tier << " no crossover found between " << first << " and " << last << " digits, keeping the existing threshold" << std::endl;
+    return 0;
+}
+
+ArithmeticThresholds Benchmark::tuneThresholds(std::ostream &log)
+{
+    std::mt19937_64 generator(20240229);
+    std::uniform_int_distribution<int> digit(0, LargeNumberArithmetic::DIGIT_BASE - 1);
+    auto randomDigits = [&](size_t size) {
+        std::vector<int> Result(size);
+        for (auto &value : Result)
+            value = digit(generator);
+        Result.back() = 1 + digit(generator) % (LargeNumberArithmetic::DIGIT_BASE - 1);
+        return Result;
+    };
+    auto convolution = [&](size_t size) -> std::function<void()> {
+        std::vector<int> firstDigits = randomDigits(size), secondDigits = randomDigits(size);
+        std::vector<long long> first(firstDigits.begin(), firstDigits.end()), second(secondDigits.begin(), secondDigits.end());
+        return [first, second]() { LargeNumberArithmetic::convolveDigits(first, second); };
+    };
+    auto multiplication = [&](size_t size) -> std::function<void()> {
+        std::vector<int> first = randomDigits(size), second = randomDigits(size);
+        return [first, second]() { LargeNumberArithmetic::multiplyDigits(first, second); };
+    };
+    auto division = [&](size_t size) -> std::function<void()> {
+        std::vector<int> dividend = randomDigits(2 * size + 2), divisor = randomDigits(size + 1);
+        return [dividend, divisor]() { LargeNumberArithmetic::divideDigits(dividend, divisor); };
+    };
+    ArithmeticThresholds &current = LargeNumberArithmetic::thresholds();
+    const ArithmeticThresholds previous = current;
+    current = ThresholdConfig::defaults();
+    current.toomCook = current.ntt = current.newtonDivision = ThresholdConfig::MAXIMUM_THRESHOLD;
+    log << "tier digits without_us with_us" << std::endl;
+    if (!findCrossover(log, "karatsuba", current.karatsuba, ThresholdConfig::MINIMUM_THRESHOLD, 512, convolution))
+        current.karatsuba = previous.karatsuba;
+    if (!findCrossover(log, "toom_cook", current.toomCook, current.karatsuba, 4096, convolution))
+        current.toomCook = previous.toomCook;
+    if (!findCrossover(log, "ntt", current.ntt, ThresholdConfig::MINIMUM_THRESHOLD, 8192, multiplication))
+        current.ntt = previous.ntt;
+    if (!findCrossover(log, "newton_division", current.newtonDivision, ThresholdConfig::MINIMUM_THRESHOLD, 4096, division))
+        current.newtonDivision = previous.newtonDivision;
+    log << "karatsuba_threshold " << current.karatsuba << std::endl;
+    log << "toom_cook_threshold " << current.toomCook << std::endl;
+    log << "ntt_threshold " << current.ntt << std::endl;
+    log << "newton_division_threshold " << current.newtonDivision << std::endl;
+    return current;
+}
+
+bool Benchmark::compareBackends(std::ostream &output, size_t count)
+{
+#if defined(RSA_USE_GMP)
+    std::mt19937_64 generator(20240229);
+    auto randomDigits = [&](size_t size) {
+        std::vector<int> Result(size);
+        int kind = generator() % 4;
+        for (auto &value : Result)
+            value = kind == 0 ? LargeNumberArithmetic::DIGIT_BASE - 1 : generator() % LargeNumberArithmetic::DIGIT_BASE;
+        while (!Result.empty() && Result.back() == 0)
+            Result.pop_back();
+        return Result;
+    };
+    auto randomSize = [&](size_t limit) { return (size_t)std::exp2((double)(generator() % 1000) / 1000 * std::log2((double)limit)); };
+    size_t mismatches = 0;
+    auto check = [&](const std::string &operation, bool same, size_t first, size_t second) {
+        if (same)
+            return;
+        if (++mismatches <= 10)
+            output << "mismatch " << operation << ' ' << first << ' ' << second << std::endl;
+    };
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::vector<int> first = randomDigits(randomSize(4000)), second = randomDigits(randomSize(4000));
+        check("multiply", NativeBackend::multiply(first, second) == GmpBackend::multiply(first, second), first.size(), second.size());
+        if (second.empty())
+            continue;
+        DigitDivisionResult native = NativeBackend::divide(first, second), gmp = GmpBackend::divide(first, second);
+        check("divide", native.quotient == gmp.quotient && native.remainder == gmp.remainder, first.size(), second.size());
+        if (i % 8 == 0)
+        {
+            std::vector<int> base = randomDigits(randomSize(160)), exponent = randomDigits(randomSize(160)), modulus = randomDigits(randomSize(160));
+            if (!modulus.empty())
+                check("power_modulo", NativeBackend::powerModulo(base, exponent, modulus) == GmpBackend::powerModulo(base, exponent, modulus), base.size(), modulus.size());
+        }
+    }
+    output << count << " cases, " << mismatches << " mismatches between " << NativeBackend::name() << " and " << GmpBackend::name() << std::endl;
+    return mismatches == 0;
+#else
+    output << "Built without RSA_USE_GMP, only the " << NativeBackend::name() << " backend is available" << std::endl;
+    return count == 0;
+#endif
+}
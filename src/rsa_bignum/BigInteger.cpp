@@ -0,0 +1,294 @@
+#include "rsa_bignum/BigInteger.h"
+#include "rsa_bignum/ArithmeticBackend.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include "rsa_bignum/OperationStats.h"
+#include <algorithm>
+
+BigInteger::BigInteger(std::string &s)
+{
+    OperationStats::count(STAT_BIG_INTEGER_CONSTRUCT);
+    digits = "";
+    int n = s.size();
+    for (int i = n - 1; i >= 0; i--)
+    {
+        if (!isdigit(s[i]))
+            throw("ERROR CONVERT");
+        else
+            digits.push_back(s[i] - '0');
+    }
+}
+
+BigInteger::BigInteger(unsigned long long numConvert)
+{
+    OperationStats::count(STAT_BIG_INTEGER_CONSTRUCT);
+    do
+    {
+        digits.push_back(numConvert % 10);
+        numConvert /= 10;
+    } while (numConvert != 0);
+}
+
+BigInteger::BigInteger(const char *s)
+{
+    OperationStats::count(STAT_BIG_INTEGER_CONSTRUCT);
+    std::string str = std::string(s);
+    digits = "";
+    for (int i = str.length() - 1; i >= 0; i--)
+    {
+        if (!isdigit(s[i]))
+            throw("ERROR CONVERT");
+        else
+            digits.push_back(s[i] - '0');
+    }
+}
+
+BigInteger::BigInteger(BigInteger &a)
+{
+    OperationStats::count(STAT_BIG_INTEGER_COPY);
+    digits = a.digits;
+}
+
+BigInteger::BigInteger(const BigInteger &a)
+{
+    OperationStats::count(STAT_BIG_INTEGER_COPY);
+    this->digits = a.digits;
+}
+
+BigInteger::BigInteger(const std::vector<int> &digitVector)
+{
+    OperationStats::count(STAT_BIG_INTEGER_CONSTRUCT);
+    digits.clear();
+    for (int digit : digitVector)
+    {
+        digits.push_back(digit % 10);
+        digits.push_back(digit / 10);
+    }
+    while (digits.size() > 1 && digits.back() == 0)
+        digits.pop_back();
+    if (digits.empty())
+        digits.push_back(0);
+}
+
+bool Null(const BigInteger &a)
+{
+    return (a.digits.size() == 1 && a.digits[0] == 0);
+}
+
+int BigInteger::operator[](const int index) const
+{
+    if (digits.size() <= index || index < 0)
+        throw("ERROR");
+    return digits[index];
+}
+
+BigInteger &BigInteger::operator=(const BigInteger &a)
+{
+    OperationStats::count(STAT_BIG_INTEGER_COPY);
+    digits = a.digits;
+    return *this;
+}
+
+BigInteger &BigInteger::operator++()
+{
+    int i, n = digits.size();
+    for (i = 0; i < n && digits[i] == 9; i++)
+        digits[i] = 0;
+    if (i == n)
+        digits.push_back(1);
+    else
+        digits[i]++;
+    return *this;
+}
+
+BigInteger BigInteger::operator++(int temp)
+{
+    BigInteger aux;
+    aux = *this;
+    ++(*this);
+    return aux;
+}
+
+BigInteger &operator+=(BigInteger &a, const BigInteger &b)
+{
+    OperationStats::count(STAT_BIG_INTEGER_ADD);
+    int carry = 0, sum;
+    size_t n = a.digits.size(), m = b.digits.size();
+    if (m > n)
+        a.digits.resize(m, 0);
+    for (size_t i = 0; i < m || carry; ++i)
+    {
+        if (i == a.digits.size())
+            a.digits.push_back(0);
+        sum = a.digits[i] + carry + (i < m ? b.digits[i] : 0);
+        a.digits[i] = sum % 10;
+        carry = sum / 10;
+    }
+    return a;
+}
+
+BigInteger operator+(const BigInteger &a, const BigInteger &b)
+{
+    BigInteger temp(a);
+    temp += b;
+    return temp;
+}
+
+BigInteger &BigInteger::operator--()
+{
+    if (digits[0] == 0 && digits.size() == 1)
+        throw("UNDERFLOW");
+    int i, n = digits.size();
+    for (i = 0; digits[i] == 0 && i < n; i++)
+        digits[i] = 9;
+    digits[i]--;
+    if (n > 1 && digits[n - 1] == 0)
+        digits.pop_back();
+    return *this;
+}
+
+BigInteger BigInteger::operator--(int temp)
+{
+    BigInteger aux;
+    aux = *this;
+    --(*this);
+    return aux;
+}
+
+BigInteger &operator-=(BigInteger &a, const BigInteger &b)
+{
+    OperationStats::count(STAT_BIG_INTEGER_SUBTRACT);
+    if (a < b)
+        throw("UNDERFLOW");
+    int n = a.digits.size(), m = b.digits.size(), t = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int s = a.digits[i] - (i < m ? b.digits[i] : 0) + t;
+        t = s < 0 ? -1 : 0;
+        a.digits[i] = s < 0 ? s + 10 : s;
+    }
+    while (n > 1 && a.digits[n - 1] == 0)
+        a.digits.pop_back(), n--;
+    return a;
+}
+
+BigInteger operator-(const BigInteger &a, const BigInteger &b)
+{
+    BigInteger temp;
+    temp = a;
+    temp -= b;
+    return temp;
+}
+
+BigInteger operator*(const BigInteger &a, const BigInteger &b)
+{
+    BigInteger temp;
+    temp = a;
+    temp *= b;
+    return temp;
+}
+
+BigInteger &operator*=(BigInteger &a, const BigInteger &b)
+{
+    OperationStats::count(STAT_BIG_INTEGER_MULTIPLY);
+    if (Null(a) || Null(b))
+    {
+        a = BigInteger();
+        return a;
+    }
+    int n = a.digits.size(), m = b.digits.size();
+    if ((size_t)std::min(n, m) / 2 >= LargeNumberArithmetic::thresholds().karatsuba)
+    {
+        a = BigInteger(ArithmeticBackend::multiply(a.toDigitVector(), b.toDigitVector()));
+        return a;
+    }
+    std::vector<int> v(n + m, 0);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < m; j++)
+            v[i + j] += a.digits[i] * b.digits[j];
+    a.digits.resize(n + m);
+    int carry = 0;
+    for (int i = 0; i < a.digits.size(); i++)
+    {
+        v[i] += carry;
+        a.digits[i] = v[i] % 10;
+        carry = v[i] / 10;
+    }
+    while (a.digits.size() > 1 && a.digits.back() == 0)
+        a.digits.pop_back();
+    return a;
+}
+
+BigInteger &operator/=(BigInteger &a, const BigInteger &b)
+{
+    OperationStats::count(STAT_BIG_INTEGER_DIVIDE);
+    if (Null(b))
+        throw("Arithmetic Error: Division By 0");
+    if (a < b)
+    {
+        a = BigInteger();
+        return a;
+    }
+    a = BigInteger(ArithmeticBackend::divide(a.toDigitVector(), b.toDigitVector()).quotient);
+    return a;
+}
+
+BigInteger operator/(const BigInteger &a, const BigInteger &b)
+{
+    BigInteger temp;
+    temp = a;
+    temp /= b;
+    return temp;
+}
+
+BigInteger &operator%=(BigInteger &a, const BigInteger &b)
+{
+    OperationStats::count(STAT_BIG_INTEGER_MODULO);
+    if (Null(b))
+        throw("Arithmetic Error: Division By 0");
+    if (a < b)
+        return a;
+    a = BigInteger(ArithmeticBackend::divide(a.toDigitVector(), b.toDigitVector()).remainder);
+    return a;
+}
+
+BigInteger operator%(const BigInteger &a, const BigInteger &b)
+{
+    BigInteger temp;
+    temp = a;
+    temp %= b;
+    return temp;
+}
+
+std::string BigInteger::toString()
+{
+    std::string res = "";
+    for (int i = this->digits.size() - 1; i >= 0; i--)
+        res = res + std::to_string((short)this->digits[i]);
+    return res;
+}
+
+std::vector<int> BigInteger::toDigitVector() const
+{
+    if (Null(*this))
+        return {};
+    std::vector<int> Result((digits.size() + 1) / 2, 0);
+    for (size_t i = 0; i < digits.size(); i++)
+        Result[i / 2] += i % 2 ? digits[i] * 10 : digits[i];
+    return Result;
+}
+
+bool operator==(const BigInteger &a, const BigInteger &b)
+{
+    return a.digits == b.digits;
+}
+
+bool operator<(const BigInteger &a, const BigInteger &b)
+{
+    size_t n = a.digits.size(), m = b.digits.size();
+    if (n != m)
+        return n < m;
+    for (size_t i = n; i-- > 0;)
+        if (a.digits[i] != b.digits[i])
+            return a.digits[i] < b.digits[i];
+    return false;
+}
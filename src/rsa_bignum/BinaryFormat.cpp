@@ -0,0 +1,218 @@
+#include "rsa_bignum/BinaryFormat.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    const char MAGIC[4] = {'R', 'S', 'A', 'B'};
+    const unsigned long long DECIMAL_CHUNK = 1000000000000000000ULL;
+    const int DECIMAL_CHUNK_DIGITS = 9;
+    const unsigned long long NEGATIVE_FLAG = 0x80000000ULL;
+
+    unsigned long long readBigEndian(const char *bytes, size_t count)
+    {
+        unsigned long long Result = 0;
+        for (size_t i = 0; i < count; ++i)
+            Result = Result << 8 | (unsigned char)bytes[i];
+        return Result;
+    }
+
+    void appendBigEndian(std::string &output, unsigned long long value, size_t count)
+    {
+        for (size_t i = count; i-- > 0;)
+            output.push_back(char(value >> (8 * i)));
+    }
+
+    int hexValue(char character)
+    {
+        if (character >= '0' && character <= '9')
+            return character - '0';
+        if (character >= 'A' && character <= 'F')
+            return character - 'A' + 10;
+        if (character >= 'a' && character <= 'f')
+            return character - 'a' + 10;
+        return -1;
+    }
+}
+
+bool BinaryFormat::readHeader(std::string_view contents, RecordType &type, unsigned long long &count)
+{
+    if (contents.size() < HEADER_SIZE || std::memcmp(contents.data(), MAGIC, sizeof(MAGIC)) != 0 || (unsigned char)contents[4] != VERSION)
+        return false;
+    type = RecordType((unsigned char)contents[5]);
+    count = readBigEndian(contents.data() + 8, 8);
+    return true;
+}
+
+bool BinaryFormat::readRecord(std::string_view contents, size_t &position, std::string_view &magnitude, bool &negative)
+{
+    if (position + 4 > contents.size())
+        return false;
+    unsigned long long prefix = readBigEndian(contents.data() + position, 4);
+    unsigned long long length = prefix & MAX_RECORD_BYTES;
+    if (position + 4 + length > contents.size())
+        return false;
+    negative = prefix & NEGATIVE_FLAG;
+    magnitude = contents.substr(position + 4, length);
+    position += 4 + length;
+    return true;
+}
+
+std::string BinaryFormat::header(RecordType type, unsigned long long count)
+{
+    std::string Result(MAGIC, sizeof(MAGIC));
+    Result.push_back(char(VERSION));
+    Result.push_back(char(type));
+    appendBigEndian(Result, 0, 2);
+    appendBigEndian(Result, count, 8);
+    return Result;
+}
+
+void BinaryFormat::appendRecord(std::string &output, std::string_view magnitude, bool negative)
+{
+    magnitude = trim(magnitude);
+    if (magnitude.size() > MAX_RECORD_BYTES)
+        throw("Binary Format Error: Record Too Large");
+    appendBigEndian(output, magnitude.size() | (negative && !magnitude.empty() ? NEGATIVE_FLAG : 0), 4);
+    output.append(magnitude);
+}
+
+void BinaryFormat::appendInteger(std::string &output, long long value)
+{
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : value;
+    std::string bytes;
+    appendBigEndian(bytes, magnitude, 8);
+    appendRecord(output, bytes, value < 0);
+}
+
+void BinaryFormat::appendHex(std::string &output, std::string_view hex)
+{
+    bool negative = !hex.empty() && hex[0] == '-';
+    appendRecord(output, fromHex(negative ? hex.substr(1) : hex), negative);
+}
+
+void BinaryFormat::appendLargeNumber(std::string &output, const LargeNumber &number)
+{
+    std::vector<unsigned long long> limbs = toLimbs(number);
+    std::string bytes;
+    for (size_t i = limbs.size(); i-- > 0;)
+        appendBigEndian(bytes, limbs[i], 8);
+    appendRecord(output, bytes, number.is_negative);
+}
+
+std::string_view BinaryFormat::trim(std::string_view magnitude)
+{
+    size_t zeros = 0;
+    while (zeros < magnitude.size() && magnitude[zeros] == 0)
+        ++zeros;
+    return magnitude.substr(zeros);
+}
+
+long long BinaryFormat::toInteger(std::string_view magnitude, bool negative)
+{
+    magnitude = trim(magnitude);
+    if (magnitude.size() > 8 || (magnitude.size() == 8 && (unsigned char)magnitude[0] & 0x80))
+        throw("Binary Format Error: Integer Out Of Range");
+    long long Result = (long long)readBigEndian(magnitude.data(), magnitude.size());
+    return negative ? -Result : Result;
+}
+
+std::vector<unsigned long long> BinaryFormat::toLimbs(std::string_view magnitude)
+{
+    magnitude = trim(magnitude);
+    std::vector<unsigned long long> Result((magnitude.size() + 7) / 8, 0);
+    for (size_t i = 0; i < Result.size(); ++i)
+    {
+        size_t end = magnitude.size() - 8 * i;
+        size_t start = end >= 8 ? end - 8 : 0;
+        Result[i] = readBigEndian(magnitude.data() + start, end - start);
+    }
+    return Result;
+}
+
+std::vector<unsigned long long> BinaryFormat::toLimbs(const LargeNumber &number)
+{
+    std::vector<int> digits = LargeNumberConversion::toDigitVector(number);
+    std::vector<unsigned long long> Result;
+    for (size_t end = digits.size(); end > 0;)
+    {
+        size_t start = end >= DECIMAL_CHUNK_DIGITS ? end - DECIMAL_CHUNK_DIGITS : 0;
+        unsigned long long chunk = 0, scale = 1;
+        for (size_t i = end; i-- > start;)
+        {
+            chunk = chunk * 100 + digits[i];
+            scale *= 100;
+        }
+        unsigned __int128 carry = chunk;
+        for (unsigned long long &limb : Result)
+        {
+            unsigned __int128 value = (unsigned __int128)limb * scale + carry;
+            limb = (unsigned long long)value;
+            carry = value >> 64;
+        }
+        if (carry)
+            Result.push_back((unsigned long long)carry);
+        end = start;
+    }
+    return Result;
+}
+
+LargeNumber BinaryFormat::fromLimbs(const unsigned long long *limbs, size_t count, bool negative)
+{
+    std::vector<unsigned long long> remaining(limbs, limbs + count);
+    while (!remaining.empty() && remaining.back() == 0)
+        remaining.pop_back();
+    std::vector<int> digits;
+    while (!remaining.empty())
+    {
+        unsigned __int128 remainder = 0;
+        for (size_t i = remaining.size(); i-- > 0;)
+        {
+            unsigned __int128 value = remainder << 64 | remaining[i];
+            remaining[i] = (unsigned long long)(value / DECIMAL_CHUNK);
+            remainder = value % DECIMAL_CHUNK;
+        }
+        while (!remaining.empty() && remaining.back() == 0)
+            remaining.pop_back();
+        unsigned long long chunk = (unsigned long long)remainder;
+        for (int i = 0; i < DECIMAL_CHUNK_DIGITS; ++i, chunk /= 100)
+            digits.push_back(int(chunk % 100));
+    }
+    while (!digits.empty() && digits.back() == 0)
+        digits.pop_back();
+    return LargeNumberConversion::fromDigitVector(digits, negative && !digits.empty());
+}
+
+LargeNumber BinaryFormat::toLargeNumber(std::string_view magnitude, bool negative)
+{
+    std::vector<unsigned long long> limbs = toLimbs(magnitude);
+    return fromLimbs(limbs.data(), limbs.size(), negative);
+}
+
+std::string BinaryFormat::toHex(std::string_view magnitude)
+{
+    magnitude = trim(magnitude);
+    if (magnitude.empty())
+        return "0";
+    std::string Result;
+    Result.reserve(2 * magnitude.size());
+    for (unsigned char byte : magnitude)
+    {
+        Result.push_back("0123456789ABCDEF"[byte >> 4]);
+        Result.push_back("0123456789ABCDEF"[byte & 15]);
+    }
+    return Result[0] == '0' ? Result.substr(1) : Result;
+}
+
+std::string BinaryFormat::fromHex(std::string_view hex)
+{
+    std::string Result((hex.size() + 1) / 2, '\0');
+    for (size_t i = 0; i < hex.size(); ++i)
+    {
+        int value = hexValue(hex[hex.size() - 1 - i]);
+        if (value < 0)
+            throw("Binary Format Error: Invalid Hexadecimal Digit");
+        Result[Result.size() - 1 - i / 2] |= char(i % 2 ? value << 4 : value);
+    }
+    return std::string(trim(Result));
+}
@@ -0,0 +1,117 @@
+#include "rsa_bignum/ConversionOperations.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include <algorithm>
+
+LargeNumber ConversionOperations::convertStringToLargeNumber(const std::string &str)
+{
+    LargeNumber final;
+    std::string temp = str;
+    final.is_negative = (temp[0] == '-');
+    if (final.is_negative)
+        temp.erase(0, 1);
+    std::reverse(temp.begin(), temp.end());
+    final.digits.resize(std::max<size_t>(1, (temp.size() + 1) / 2), 0);
+    int val = 0, multiplier = 1, digit_index = 0;
+    for (char c : temp)
+    {
+        val += (c - '0') * multiplier;
+        multiplier *= 10;
+        if (multiplier == 100)
+        {
+            final.digits[digit_index++] = val;
+            val = 0;
+            multiplier = 1;
+        }
+    }
+    if (val > 0)
+        final.digits[digit_index] = val;
+    LargeNumberConversion::trimLeadingZeros(final);
+    return final;
+}
+
+BigInteger ConversionOperations::convertHexBigEndianToDecimal(std::string_view hexVal)
+{
+    int len = hexVal.size();
+    BigInteger base("1");
+    BigInteger dec_val("0");
+    for (int i = len - 1; i >= 0; i--)
+    {
+        if (hexVal[i] >= '0' && hexVal[i] <= '9')
+        {
+            dec_val += (hexVal[i] - '0') * base;
+            base = base * 16;
+        }
+        else if (hexVal[i] >= 'A' && hexVal[i] <= 'F')
+        {
+            dec_val += (hexVal[i] - '7') * base;
+            base = base * 16;
+        }
+    }
+    return dec_val;
+}
+
+std::string ConversionOperations::convertDecimalToHexBigEndian(LargeNumber decimal)
+{
+    if (LargeNumberConversion::isEqualToZero(decimal))
+        return "0";
+    std::string res;
+    LargeNumber Sixteen;
+    Sixteen.digits[0] = 16;
+    while (!LargeNumberConversion::isEqualToZero(decimal))
+    {
+        int rem = LargeNumberArithmetic::divideByLargeNumber(decimal, Sixteen).remainder.digits[0];
+        res = (rem < 10) ? std::to_string(rem) + res : std::string(1, 'A' + rem - 10) + res;
+        decimal = LargeNumberArithmetic::divideByLargeNumber(decimal, Sixteen).quotient;
+    }
+    return res;
+}
+
+std::string ConversionOperations::convertBigIntegerToHexBigEndian(const BigInteger &decimal)
+{
+    std::vector<int> digits = decimal.toDigitVector();
+    if (digits.empty())
+        return "0";
+    const std::vector<int> Base65536 = {36, 55, 6};
+    std::string res;
+    while (!digits.empty())
+    {
+        DigitDivisionResult DR = LargeNumberArithmetic::divideDigits(digits, Base65536);
+        int rem = 0;
+        for (size_t i = DR.remainder.size(); i-- > 0;)
+            rem = rem * LargeNumberArithmetic::DIGIT_BASE + DR.remainder[i];
+        for (int i = 0; i < 4 && (rem != 0 || !DR.quotient.empty()); ++i, rem /= 16)
+            res.push_back("0123456789ABCDEF"[rem % 16]);
+        digits = DR.quotient;
+    }
+    std::reverse(res.begin(), res.end());
+    return res;
+}
+
+std::string ConversionOperations::convertLargeNumberToString(LargeNumber input)
+{
+    std::string out;
+    if (input.is_negative)
+        out += "-";
+    std::reverse(input.digits.begin(), input.digits.end());
+    bool leadingZero = true;
+    for (size_t i = 0; i < input.digits.size(); ++i)
+    {
+        int value = input.digits[i];
+        for (int div = 10; div > 0; div /= 10)
+        {
+            int digit = value / div;
+            value %= div;
+            if (digit != 0 || !leadingZero)
+            {
+                out += (digit + '0');
+                leadingZero = false;
+            }
+        }
+    }
+    return out.empty() || out == "-" ? "0" : out;
+}
+
+LargeNumber ConversionOperations::convertHexToLargeNumber(std::string_view hexVal)
+{
+    return convertStringToLargeNumber(convertHexBigEndianToDecimal(hexVal).toString());
+}
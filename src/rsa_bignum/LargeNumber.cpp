@@ -0,0 +1,89 @@
+#include "rsa_bignum/LargeNumber.h"
+#include "rsa_bignum/OperationStats.h"
+#include <utility>
+
+LargeNumber::LargeNumber()
+{
+    OperationStats::count(STAT_LARGE_NUMBER_CONSTRUCT);
+}
+
+LargeNumber::LargeNumber(const LargeNumber &other) : digits(other.digits), is_negative(other.is_negative)
+{
+    OperationStats::count(STAT_LARGE_NUMBER_COPY);
+    OperationStats::count(STAT_DIGITS_COPIED, digits.size());
+}
+
+LargeNumber::LargeNumber(LargeNumber &&other) noexcept : digits(std::move(other.digits)), is_negative(other.is_negative)
+{
+    OperationStats::count(STAT_LARGE_NUMBER_MOVE);
+}
+
+LargeNumber &LargeNumber::operator=(const LargeNumber &other)
+{
+    OperationStats::count(STAT_LARGE_NUMBER_COPY);
+    OperationStats::count(STAT_DIGITS_COPIED, other.digits.size());
+    digits = other.digits;
+    is_negative = other.is_negative;
+    return *this;
+}
+
+LargeNumber &LargeNumber::operator=(LargeNumber &&other) noexcept
+{
+    OperationStats::count(STAT_LARGE_NUMBER_MOVE);
+    digits = std::move(other.digits);
+    is_negative = other.is_negative;
+    return *this;
+}
+
+LargeNumber LargeNumberConversion::copyLargeNumber(const LargeNumber &number)
+{
+    LargeNumber Result = number;
+    trimLeadingZeros(Result);
+    return Result;
+}
+
+LargeNumber LargeNumberConversion::addLeadingDigit(const LargeNumber &number, int digit)
+{
+    LargeNumber Result = number;
+    Result.digits.push_back(0);
+    OperationStats::count(STAT_DIGITS_COPIED, Result.digits.size() - 1);
+    for (size_t i = Result.digits.size() - 1; i > 0; --i)
+        Result.digits[i] = Result.digits[i - 1];
+    Result.digits[0] = digit;
+    trimLeadingZeros(Result);
+    return Result;
+}
+
+bool LargeNumberConversion::isEqualToZero(const LargeNumber &number)
+{
+    for (int digit : number.digits)
+        if (digit != 0)
+            return false;
+    return true;
+}
+
+void LargeNumberConversion::trimLeadingZeros(LargeNumber &number)
+{
+    while (number.digits.size() > 1 && number.digits.back() == 0)
+        number.digits.pop_back();
+    if (number.digits.empty())
+        number.digits.push_back(0);
+}
+
+std::vector<int> LargeNumberConversion::toDigitVector(const LargeNumber &number)
+{
+    std::vector<int> Result = number.digits.toVector();
+    while (!Result.empty() && Result.back() == 0)
+        Result.pop_back();
+    return Result;
+}
+
+LargeNumber LargeNumberConversion::fromDigitVector(const std::vector<int> &digits, bool is_negative)
+{
+    LargeNumber Result;
+    if (!digits.empty())
+        Result.digits = SmallDigitVector(digits);
+    Result.is_negative = is_negative;
+    trimLeadingZeros(Result);
+    return Result;
+}
@@ -0,0 +1,783 @@
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include "rsa_bignum/ArithmeticBackend.h"
+#include "rsa_bignum/OperationStats.h"
+#include "rsa_bignum/ThresholdConfig.h"
+#include "rsa_bignum/Utils.h"
+#include <algorithm>
+
+LargeNumber LargeNumberArithmetic::addLargeNumbers(LargeNumber first, LargeNumber second)
+{
+    OperationStats::count(STAT_ADD);
+    if (LargeNumberConversion::isEqualToZero(first))
+        return second;
+    if (LargeNumberConversion::isEqualToZero(second))
+        return first;
+    bool BothNegative = first.is_negative && second.is_negative;
+    if (first.is_negative)
+    {
+        first.is_negative = false;
+        return subtractLargeNumbers(second, first);
+    }
+    if (second.is_negative)
+    {
+        second.is_negative = false;
+        return subtractLargeNumbers(first, second);
+    }
+    size_t length = std::max(first.digits.size(), second.digits.size());
+    first.digits.resize(length, 0);
+    second.digits.resize(length, 0);
+    LargeNumber Result;
+    Result.digits.resize(length + 1, 0);
+    int carry = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        int sum = first.digits[i] + second.digits[i] + carry;
+        Result.digits[i] = sum % 100;
+        carry = sum / 100;
+    }
+    Result.digits[length] = carry;
+    LargeNumberConversion::trimLeadingZeros(Result);
+    Result.is_negative = BothNegative;
+    return Result;
+}
+
+LargeNumber LargeNumberArithmetic::subtractLargeNumbers(LargeNumber minuend, LargeNumber subtrahend)
+{
+    OperationStats::count(STAT_SUBTRACT);
+    if (LargeNumberConversion::isEqualToZero(subtrahend))
+        return minuend;
+    if (LargeNumberConversion::isEqualToZero(minuend))
+    {
+        subtrahend.is_negative = true;
+        return subtrahend;
+    }
+    if (subtrahend.is_negative)
+    {
+        if (minuend.is_negative)
+        {
+            minuend.is_negative = subtrahend.is_negative = false;
+            return subtractLargeNumbers(subtrahend, minuend);
+        }
+        subtrahend.is_negative = false;
+        return addLargeNumbers(minuend, subtrahend);
+    }
+    if (minuend.is_negative)
+    {
+        minuend.is_negative = subtrahend.is_negative = false;
+        LargeNumber result = addLargeNumbers(minuend, subtrahend);
+        result.is_negative = true;
+        return result;
+    }
+    size_t length = std::max(minuend.digits.size(), subtrahend.digits.size());
+    minuend.digits.resize(length, 0);
+    subtrahend.digits.resize(length, 0);
+    LargeNumber Result = minuend;
+    bool borrow = false;
+    for (size_t i = 0; i < length; i++)
+    {
+        int diff = Result.digits[i] - subtrahend.digits[i] - borrow;
+        if (diff < 0)
+        {
+            diff += 100;
+            borrow = true;
+        }
+        else
+            borrow = false;
+        Result.digits[i] = diff;
+    }
+    if (borrow)
+    {
+        LargeNumber temp = subtractLargeNumbers(subtrahend, minuend);
+        temp.is_negative = true;
+        return temp;
+    }
+    LargeNumberConversion::trimLeadingZeros(Result);
+    return Result;
+}
+
+LargeNumber LargeNumberArithmetic::multiplyLargeNumbers(LargeNumber first, LargeNumber second)
+{
+    OperationStats::count(STAT_MULTIPLY);
+    if (LargeNumberConversion::isEqualToZero(first) || LargeNumberConversion::isEqualToZero(second))
+        return LargeNumber();
+    bool neg = first.is_negative ^ second.is_negative;
+    return LargeNumberConversion::fromDigitVector(ArithmeticBackend::multiply(first.digits, second.digits), neg);
+}
+
+DivisionResult LargeNumberArithmetic::divideByLargeNumber(LargeNumber dividend, LargeNumber divisor)
+{
+    OperationStats::count(STAT_DIVIDE);
+    bool neg = dividend.is_negative != divisor.is_negative;
+    DigitDivisionResult Digits = ArithmeticBackend::divide(dividend.digits, divisor.digits);
+    DivisionResult Result;
+    Result.quotient = LargeNumberConversion::fromDigitVector(Digits.quotient, neg);
+    Result.remainder = LargeNumberConversion::fromDigitVector(Digits.remainder, neg);
+    return Result;
+}
+
+ArithmeticThresholds &LargeNumberArithmetic::thresholds()
+{
+    static ArithmeticThresholds Result = ThresholdConfig::load(ThresholdConfig::configPath());
+    return Result;
+}
+
+long long LargeNumberArithmetic::maximumMagnitude(const std::vector<long long> &coefficients)
+{
+    long long Result = 0;
+    for (long long coefficient : coefficients)
+        Result = std::max(Result, coefficient < 0 ? -coefficient : coefficient);
+    return Result;
+}
+
+std::vector<long long> LargeNumberArithmetic::convolveDigits(const std::vector<long long> &first, const std::vector<long long> &second)
+{
+    if (first.size() < second.size())
+        return convolveDigits(second, first);
+    if (second.empty())
+        return {};
+    if (second.size() >= thresholds().karatsuba && 2 * second.size() <= first.size())
+    {
+        std::vector<long long> Result(first.size() + second.size() - 1, 0);
+        for (size_t offset = 0; offset < first.size(); offset += second.size())
+        {
+            std::vector<long long> block(first.begin() + offset, first.begin() + std::min(first.size(), offset + second.size()));
+            std::vector<long long> partial = convolveDigits(block, second);
+            for (size_t i = 0; i < partial.size(); i++)
+                Result[offset + i] += partial[i];
+        }
+        return Result;
+    }
+    long double bound = (long double)maximumMagnitude(first) * maximumMagnitude(second);
+    if (second.size() >= thresholds().toomCook && 49 * bound * (second.size() / 3 + 1) < CONVOLUTION_LIMIT)
+        return convolveToomCook3(first, second);
+    if (second.size() >= thresholds().karatsuba && 4 * bound * (second.size() / 2 + 1) < CONVOLUTION_LIMIT)
+        return convolveKaratsuba(first, second);
+    return convolveSchoolbook(first, second);
+}
+
+std::vector<long long> LargeNumberArithmetic::convolveSchoolbook(const std::vector<long long> &first, const std::vector<long long> &second)
+{
+    OperationStats::count(STAT_MULTIPLY_SCHOOLBOOK);
+    if (first.empty() || second.empty())
+        return {};
+    std::vector<long long> Result(first.size() + second.size() - 1, 0);
+    for (size_t i = 0; i < first.size(); i++)
+    {
+        if (first[i] == 0)
+            continue;
+        for (size_t j = 0; j < second.size(); j++)
+            Result[i + j] += first[i] * second[j];
+    }
+    return Result;
+}
+
+std::vector<long long> LargeNumberArithmetic::convolveKaratsuba(const std::vector<long long> &first, const std::vector<long long> &second)
+{
+    OperationStats::count(STAT_MULTIPLY_KARATSUBA);
+    if (first.size() < second.size())
+        return convolveKaratsuba(second, first);
+    if (second.empty() || 2 * second.size() <= first.size())
+        return convolveDigits(first, second);
+    std::vector<long long> Result(first.size() + second.size(), 0);
+    size_t half = (first.size() + 1) / 2;
+    std::vector<long long> lowFirst(first.begin(), first.begin() + half), highFirst(first.begin() + half, first.end());
+    std::vector<long long> lowSecond(second.begin(), second.begin() + half), highSecond(second.begin() + half, second.end());
+    std::vector<long long> lowProduct = convolveDigits(lowFirst, lowSecond);
+    std::vector<long long> highProduct = convolveDigits(highFirst, highSecond);
+    for (size_t i = 0; i < highFirst.size(); i++)
+        lowFirst[i] += highFirst[i];
+    for (size_t i = 0; i < highSecond.size(); i++)
+        lowSecond[i] += highSecond[i];
+    std::vector<long long> middleProduct = convolveDigits(lowFirst, lowSecond);
+    for (size_t i = 0; i < lowProduct.size(); i++)
+    {
+        middleProduct[i] -= lowProduct[i];
+        Result[i] += lowProduct[i];
+    }
+    for (size_t i = 0; i < highProduct.size(); i++)
+    {
+        middleProduct[i] -= highProduct[i];
+        Result[i + 2 * half] += highProduct[i];
+    }
+    for (size_t i = 0; i < middleProduct.size() && i + half < Result.size(); i++)
+        Result[i + half] += middleProduct[i];
+    Result.resize(first.size() + second.size() - 1);
+    return Result;
+}
+
+std::vector<long long> LargeNumberArithmetic::convolveToomCook3(const std::vector<long long> &first, const std::vector<long long> &second)
+{
+    OperationStats::count(STAT_MULTIPLY_TOOM_COOK);
+    if (first.size() < second.size())
+        return convolveToomCook3(second, first);
+    if (second.empty() || 2 * second.size() <= first.size())
+        return convolveDigits(first, second);
+    size_t third = (first.size() + 2) / 3;
+    auto split = [third](const std::vector<long long> &digits, size_t part)
+    {
+        size_t from = std::min(digits.size(), part * third), to = std::min(digits.size(), from + third);
+        std::vector<long long> piece(digits.begin() + from, digits.begin() + to);
+        piece.resize(third, 0);
+        return piece;
+    };
+    auto evaluate = [third](const std::vector<long long> &low, const std::vector<long long> &middle, const std::vector<long long> &high, long long x)
+    {
+        std::vector<long long> value(third);
+        for (size_t i = 0; i < third; i++)
+            value[i] = low[i] + x * middle[i] + x * x * high[i];
+        return value;
+    };
+    std::vector<long long> a0 = split(first, 0), a1 = split(first, 1), a2 = split(first, 2);
+    std::vector<long long> b0 = split(second, 0), b1 = split(second, 1), b2 = split(second, 2);
+    std::vector<long long> r0 = convolveDigits(a0, b0);
+    std::vector<long long> r1 = convolveDigits(evaluate(a0, a1, a2, 1), evaluate(b0, b1, b2, 1));
+    std::vector<long long> rm1 = convolveDigits(evaluate(a0, a1, a2, -1), evaluate(b0, b1, b2, -1));
+    std::vector<long long> r2 = convolveDigits(evaluate(a0, a1, a2, 2), evaluate(b0, b1, b2, 2));
+    std::vector<long long> rInfinity = convolveDigits(a2, b2);
+    std::vector<long long> Result(first.size() + second.size() + 4 * third, 0);
+    for (size_t i = 0; i < 2 * third - 1; i++)
+    {
+        long long c0 = r0[i], c4 = rInfinity[i];
+        long long c2 = (r1[i] + rm1[i]) / 2 - c0 - c4;
+        long long odd = (r1[i] - rm1[i]) / 2;
+        long long c3 = ((r2[i] - c0 - 4 * c2 - 16 * c4) / 2 - odd) / 3;
+        long long c1 = odd - c3;
+        Result[i] += c0;
+        Result[i + third] += c1;
+        Result[i + 2 * third] += c2;
+        Result[i + 3 * third] += c3;
+        Result[i + 4 * third] += c4;
+    }
+    Result.resize(first.size() + second.size() - 1);
+    return Result;
+}
+
+std::vector<int> LargeNumberArithmetic::normalizeDigits(const std::vector<long long> &coefficients)
+{
+    std::vector<int> Result;
+    Result.reserve(coefficients.size() + 4);
+    long long carry = 0;
+    for (size_t i = 0; i < coefficients.size() || carry > 0; i++)
+    {
+        long long value = carry + (i < coefficients.size() ? coefficients[i] : 0);
+        long long digit = value % DIGIT_BASE;
+        carry = value / DIGIT_BASE;
+        if (digit < 0)
+        {
+            digit += DIGIT_BASE;
+            carry--;
+        }
+        Result.push_back((int)digit);
+    }
+    while (!Result.empty() && Result.back() == 0)
+        Result.pop_back();
+    return Result;
+}
+
+std::vector<int> LargeNumberArithmetic::multiplyDigits(DigitSpan first, DigitSpan second)
+{
+    size_t n = first.size(), m = second.size();
+    while (n > 0 && first[n - 1] == 0)
+        n--;
+    while (m > 0 && second[m - 1] == 0)
+        m--;
+    if (std::min(n, m) >= thresholds().ntt)
+        return multiplyDigitsNtt(std::vector<int>(first.begin(), first.begin() + n), std::vector<int>(second.begin(), second.begin() + m));
+    std::vector<long long> firstCoefficients(first.begin(), first.begin() + n), secondCoefficients(second.begin(), second.begin() + m);
+    return normalizeDigits(convolveDigits(firstCoefficients, secondCoefficients));
+}
+
+NttPrime::NttPrime(unsigned long long modulus, unsigned long long generator) : modulus(modulus), generator(generator)
+{
+    unsigned long long Inverse = modulus;
+    for (int i = 0; i < 6; i++)
+        Inverse *= 2 - modulus * Inverse;
+    inverse = 0 - Inverse;
+    unsigned __int128 square = ((unsigned __int128)1 << 64) % modulus;
+    montgomerySquare = (unsigned long long)(square * square % modulus);
+    halfMontgomery = toMontgomery((modulus + 1) / 2);
+    for (unsigned long long order = 1; (modulus - 1) % order == 0; order *= 2)
+    {
+        unsigned long long root = power(generator, (modulus - 1) / order);
+        roots.push_back(toMontgomery(root));
+        inverseRoots.push_back(toMontgomery(power(root, modulus - 2)));
+    }
+}
+
+unsigned long long NttPrime::add(unsigned long long first, unsigned long long second) const
+{
+    unsigned long long Result = first + second;
+    return Result >= modulus ? Result - modulus : Result;
+}
+
+unsigned long long NttPrime::subtract(unsigned long long first, unsigned long long second) const
+{
+    return first >= second ? first - second : first + modulus - second;
+}
+
+unsigned long long NttPrime::multiply(unsigned long long first, unsigned long long second) const
+{
+    unsigned __int128 product = (unsigned __int128)first * second;
+    unsigned long long factor = (unsigned long long)product * inverse;
+    unsigned long long Result = (unsigned long long)((product + (unsigned __int128)factor * modulus) >> 64);
+    return Result >= modulus ? Result - modulus : Result;
+}
+
+unsigned long long NttPrime::toMontgomery(unsigned long long value) const
+{
+    return multiply(value, montgomerySquare);
+}
+
+unsigned long long NttPrime::power(unsigned long long base, unsigned long long exponent) const
+{
+    unsigned long long Result = 1;
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+            Result = (unsigned long long)((unsigned __int128)Result * base % modulus);
+        base = (unsigned long long)((unsigned __int128)base * base % modulus);
+        exponent >>= 1;
+    }
+    return Result;
+}
+
+const NttPrime &LargeNumberArithmetic::nttPrime(size_t index)
+{
+    static const NttPrime primes[3] = {
+        NttPrime(4611615649683210241ULL, 11),
+        NttPrime(4611613450659954689ULL, 3),
+        NttPrime(4611549678985543681ULL, 19)};
+    return primes[index];
+}
+
+std::vector<unsigned long long> LargeNumberArithmetic::buildNttRoots(const NttPrime &prime, size_t size, bool inverted)
+{
+    std::vector<unsigned long long> Result(std::max<size_t>(size, 2));
+    size_t level = 1;
+    for (size_t half = 1; half < size; half *= 2, level++)
+    {
+        unsigned long long step = inverted ? prime.inverseRoots[level] : prime.roots[level], current = prime.toMontgomery(1);
+        for (size_t j = 0; j < half; j++)
+        {
+            Result[half + j] = current;
+            current = prime.multiply(current, step);
+        }
+    }
+    return Result;
+}
+
+void LargeNumberArithmetic::transformForward(std::vector<unsigned long long> &values, const std::vector<unsigned long long> &roots, const NttPrime &prime, bool parallel)
+{
+    size_t size = values.size();
+    auto butterflies = [&](size_t group, size_t first, size_t last, size_t half)
+    {
+        for (size_t j = first; j < last; j++)
+        {
+            unsigned long long u = values[group + j], v = values[group + j + half];
+            values[group + j] = prime.add(u, v);
+            values[group + j + half] = prime.multiply(prime.subtract(u, v), roots[half + j]);
+        }
+    };
+    size_t half = size / 2;
+    for (; half >= 1 && 2 * half > NTT_BLOCK_SIZE; half /= 2)
+        if (parallel)
+            Utils::parallelFor(size / NTT_BLOCK_SIZE, [&](size_t chunk)
+            {
+                size_t first = chunk * (NTT_BLOCK_SIZE / 2);
+                butterflies(first / half * 2 * half, first % half, first % half + NTT_BLOCK_SIZE / 2, half);
+            });
+        else
+            for (size_t group = 0; group < size; group += 2 * half)
+                butterflies(group, 0, half, half);
+    auto block = [&](size_t begin)
+    {
+        for (size_t inner = half; inner >= 1; inner /= 2)
+            for (size_t group = begin; group < begin + 2 * half; group += 2 * inner)
+                butterflies(group, 0, inner, inner);
+    };
+    if (half < 1)
+        return;
+    if (parallel)
+        Utils::parallelFor(size / (2 * half), [&](size_t index) { block(index * 2 * half); });
+    else
+        for (size_t begin = 0; begin < size; begin += 2 * half)
+            block(begin);
+}
+
+void LargeNumberArithmetic::transformInverse(std::vector<unsigned long long> &values, const std::vector<unsigned long long> &roots, const NttPrime &prime, bool parallel)
+{
+    size_t size = values.size();
+    auto butterflies = [&](size_t group, size_t first, size_t last, size_t half)
+    {
+        for (size_t j = first; j < last; j++)
+        {
+            unsigned long long u = values[group + j], v = prime.multiply(values[group + j + half], roots[half + j]);
+            values[group + j] = prime.add(u, v);
+            values[group + j + half] = prime.subtract(u, v);
+        }
+    };
+    size_t blockHalf = std::min(size, NTT_BLOCK_SIZE) / 2;
+    auto block = [&](size_t begin)
+    {
+        for (size_t inner = 1; inner <= blockHalf; inner *= 2)
+            for (size_t group = begin; group < begin + 2 * blockHalf; group += 2 * inner)
+                butterflies(group, 0, inner, inner);
+    };
+    if (blockHalf >= 1)
+    {
+        if (parallel)
+            Utils::parallelFor(size / (2 * blockHalf), [&](size_t index) { block(index * 2 * blockHalf); });
+        else
+            for (size_t begin = 0; begin < size; begin += 2 * blockHalf)
+                block(begin);
+    }
+    for (size_t half = 2 * blockHalf; half < size; half *= 2)
+        if (parallel)
+            Utils::parallelFor(size / NTT_BLOCK_SIZE, [&](size_t chunk)
+            {
+                size_t first = chunk * (NTT_BLOCK_SIZE / 2);
+                butterflies(first / half * 2 * half, first % half, first % half + NTT_BLOCK_SIZE / 2, half);
+            });
+        else
+            for (size_t group = 0; group < size; group += 2 * half)
+                butterflies(group, 0, half, half);
+}
+
+std::vector<int> LargeNumberArithmetic::multiplyDigitsNtt(const std::vector<int> &first, const std::vector<int> &second)
+{
+    OperationStats::count(STAT_MULTIPLY_NTT);
+    auto pack = [](const std::vector<int> &digits)
+    {
+        std::vector<unsigned long long> limbs((digits.size() + NTT_LIMB_DIGITS - 1) / NTT_LIMB_DIGITS, 0);
+        for (size_t i = digits.size(); i-- > 0;)
+            limbs[i / NTT_LIMB_DIGITS] = limbs[i / NTT_LIMB_DIGITS] * DIGIT_BASE + digits[i];
+        return limbs;
+    };
+    std::vector<unsigned long long> firstLimbs = pack(first), secondLimbs = pack(second);
+    size_t length = firstLimbs.size() + secondLimbs.size() - 1, size = 2;
+    while (size < length)
+        size *= 2;
+    std::vector<std::vector<unsigned long long>> transforms(3);
+    const bool parallel = size >= NTT_PARALLEL_THRESHOLD;
+    for (size_t index = 0; index < 3; index++)
+    {
+        const NttPrime &prime = nttPrime(index);
+        std::vector<unsigned long long> roots = buildNttRoots(prime, size, false);
+        std::vector<unsigned long long> &values = transforms[index];
+        std::vector<unsigned long long> other(size, 0);
+        values.assign(size, 0);
+        std::copy(firstLimbs.begin(), firstLimbs.end(), values.begin());
+        std::copy(secondLimbs.begin(), secondLimbs.end(), other.begin());
+        transformForward(values, roots, prime, parallel);
+        transformForward(other, roots, prime, parallel);
+        unsigned long long scale = prime.montgomerySquare;
+        for (size_t half = 1; half < size; half *= 2)
+            scale = prime.multiply(scale, prime.halfMontgomery);
+        auto pointwise = [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                values[i] = prime.multiply(prime.multiply(values[i], other[i]), scale);
+        };
+        if (parallel)
+            Utils::parallelFor(size / NTT_BLOCK_SIZE, [&](size_t chunk) { pointwise(chunk * NTT_BLOCK_SIZE, (chunk + 1) * NTT_BLOCK_SIZE); });
+        else
+            pointwise(0, size);
+        transformInverse(values, buildNttRoots(prime, size, true), prime, parallel);
+    }
+    const NttPrime &p0 = nttPrime(0), &p1 = nttPrime(1), &p2 = nttPrime(2);
+    static const unsigned long long inverse01 = p1.power(p0.modulus % p1.modulus, p1.modulus - 2);
+    static const unsigned long long inverse02 = p2.power(p0.modulus % p2.modulus, p2.modulus - 2);
+    static const unsigned long long inverse12 = p2.power(p1.modulus % p2.modulus, p2.modulus - 2);
+    unsigned __int128 modulus01 = (unsigned __int128)p0.modulus * p1.modulus;
+    unsigned long long carry[3] = {0, 0, 0};
+    std::vector<int> Result;
+    Result.reserve((length + 3) * NTT_LIMB_DIGITS);
+    for (size_t i = 0; i < length || carry[0] || carry[1] || carry[2]; i++)
+    {
+        unsigned long long value[3] = {0, 0, 0};
+        if (i < length)
+        {
+            unsigned long long r0 = transforms[0][i], r1 = transforms[1][i], r2 = transforms[2][i];
+            unsigned long long y1 = (unsigned long long)((unsigned __int128)p1.subtract(r1 % p1.modulus, r0 % p1.modulus) * inverse01 % p1.modulus);
+            unsigned long long y2 = (unsigned long long)((unsigned __int128)p2.subtract(r2 % p2.modulus, r0 % p2.modulus) * inverse02 % p2.modulus);
+            y2 = (unsigned long long)((unsigned __int128)p2.subtract(y2, y1 % p2.modulus) * inverse12 % p2.modulus);
+            unsigned __int128 low = (unsigned __int128)p0.modulus * y1 + r0;
+            unsigned __int128 high = (unsigned __int128)(unsigned long long)modulus01 * y2;
+            unsigned __int128 top = (unsigned __int128)(unsigned long long)(modulus01 >> 64) * y2;
+            unsigned __int128 word = (unsigned __int128)(unsigned long long)low + (unsigned long long)high;
+            value[0] = (unsigned long long)word;
+            word = (word >> 64) + (unsigned long long)(low >> 64) + (unsigned long long)(high >> 64) + (unsigned long long)top;
+            value[1] = (unsigned long long)word;
+            value[2] = (unsigned long long)((word >> 64) + (unsigned long long)(top >> 64));
+        }
+        unsigned __int128 word = (unsigned __int128)value[0] + carry[0];
+        carry[0] = (unsigned long long)word;
+        word = (word >> 64) + value[1] + carry[1];
+        carry[1] = (unsigned long long)word;
+        carry[2] = (unsigned long long)((word >> 64) + value[2] + carry[2]);
+        unsigned __int128 remainder = 0;
+        for (int w = 2; w >= 0; w--)
+        {
+            unsigned __int128 current = (remainder << 64) | carry[w];
+            carry[w] = (unsigned long long)(current / NTT_LIMB_BASE);
+            remainder = current % NTT_LIMB_BASE;
+        }
+        unsigned long long limb = (unsigned long long)remainder;
+        for (size_t d = 0; d < NTT_LIMB_DIGITS; d++)
+        {
+            Result.push_back((int)(limb % DIGIT_BASE));
+            limb /= DIGIT_BASE;
+        }
+    }
+    while (!Result.empty() && Result.back() == 0)
+        Result.pop_back();
+    return Result;
+}
+
+std::vector<int> LargeNumberArithmetic::addDigits(const std::vector<int> &first, const std::vector<int> &second)
+{
+    std::vector<int> Result(std::max(first.size(), second.size()) + 1, 0);
+    int carry = 0;
+    for (size_t i = 0; i < Result.size(); i++)
+    {
+        int sum = carry + (i < first.size() ? first[i] : 0) + (i < second.size() ? second[i] : 0);
+        Result[i] = sum % DIGIT_BASE;
+        carry = sum / DIGIT_BASE;
+    }
+    while (!Result.empty() && Result.back() == 0)
+        Result.pop_back();
+    return Result;
+}
+
+std::vector<int> LargeNumberArithmetic::subtractDigits(const std::vector<int> &minuend, const std::vector<int> &subtrahend)
+{
+    std::vector<int> Result(minuend);
+    int borrow = 0;
+    for (size_t i = 0; i < Result.size(); i++)
+    {
+        int difference = Result[i] - borrow - (i < subtrahend.size() ? subtrahend[i] : 0);
+        borrow = difference < 0;
+        Result[i] = difference + (borrow ? DIGIT_BASE : 0);
+        if (!borrow && i >= subtrahend.size())
+            break;
+    }
+    while (!Result.empty() && Result.back() == 0)
+        Result.pop_back();
+    return Result;
+}
+
+std::vector<int> LargeNumberArithmetic::shiftDigitsLeft(const std::vector<int> &digits, size_t count)
+{
+    if (digits.empty())
+        return digits;
+    std::vector<int> Result(count, 0);
+    Result.insert(Result.end(), digits.begin(), digits.end());
+    return Result;
+}
+
+std::vector<int> LargeNumberArithmetic::shiftDigitsRight(const std::vector<int> &digits, size_t count)
+{
+    if (digits.size() <= count)
+        return {};
+    return std::vector<int>(digits.begin() + count, digits.end());
+}
+
+int LargeNumberArithmetic::compareDigits(DigitSpan first, DigitSpan second)
+{
+    size_t n = first.size(), m = second.size();
+    while (n > 0 && first[n - 1] == 0)
+        n--;
+    while (m > 0 && second[m - 1] == 0)
+        m--;
+    if (n != m)
+        return n < m ? -1 : 1;
+    for (size_t i = n; i-- > 0;)
+        if (first[i] != second[i])
+            return first[i] < second[i] ? -1 : 1;
+    return 0;
+}
+
+std::vector<int> LargeNumberArithmetic::reciprocalDigits(const std::vector<int> &divisor)
+{
+    size_t m = divisor.size();
+    std::vector<int> power(2 * m + 1, 0);
+    power[2 * m] = 1;
+    if (m <= thresholds().newtonDivision)
+        return divideDigitsSchoolbook(power, divisor).quotient;
+    size_t k = m / 2 + 2;
+    std::vector<int> high(divisor.end() - k, divisor.end());
+    std::vector<int> reciprocal = reciprocalDigits(high);
+    std::vector<int> approximation = shiftDigitsLeft(reciprocal, m - k);
+    std::vector<int> correction = shiftDigitsRight(multiplyDigits(multiplyDigits(reciprocal, reciprocal), divisor), 2 * k);
+    std::vector<int> Result = subtractDigits(addDigits(approximation, approximation), correction);
+    std::vector<int> check = multiplyDigits(Result, divisor);
+    while (compareDigits(check, power) > 0)
+    {
+        Result = subtractDigits(Result, {1});
+        check = subtractDigits(check, divisor);
+    }
+    std::vector<int> remainder = subtractDigits(power, check);
+    while (compareDigits(remainder, divisor) >= 0)
+    {
+        Result = addDigits(Result, {1});
+        remainder = subtractDigits(remainder, divisor);
+    }
+    return Result;
+}
+
+DigitDivisionResult LargeNumberArithmetic::divideDigitsSchoolbook(DigitSpan dividend, DigitSpan divisor)
+{
+    OperationStats::count(STAT_DIVIDE_SCHOOLBOOK);
+    DigitDivisionResult Result;
+    size_t n = dividend.size(), m = divisor.size();
+    while (n > 0 && dividend[n - 1] == 0)
+        n--;
+    while (m > 0 && divisor[m - 1] == 0)
+        m--;
+    if (n < m || compareDigits(dividend, divisor) < 0)
+    {
+        Result.remainder.assign(dividend.begin(), dividend.begin() + n);
+        return Result;
+    }
+    if (m == 1)
+    {
+        Result.quotient.assign(n, 0);
+        long long remainder = 0;
+        for (size_t i = n; i-- > 0;)
+        {
+            long long value = remainder * DIGIT_BASE + dividend[i];
+            Result.quotient[i] = (int)(value / divisor[0]);
+            remainder = value % divisor[0];
+        }
+        while (!Result.quotient.empty() && Result.quotient.back() == 0)
+            Result.quotient.pop_back();
+        if (remainder != 0)
+            Result.remainder.push_back((int)remainder);
+        return Result;
+    }
+    long long factor = DIGIT_BASE / (divisor[m - 1] + 1);
+    std::vector<long long> u(n + 1, 0), v(m, 0);
+    long long carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        long long value = dividend[i] * factor + carry;
+        u[i] = value % DIGIT_BASE;
+        carry = value / DIGIT_BASE;
+    }
+    u[n] = carry;
+    carry = 0;
+    for (size_t i = 0; i < m; i++)
+    {
+        long long value = divisor[i] * factor + carry;
+        v[i] = value % DIGIT_BASE;
+        carry = value / DIGIT_BASE;
+    }
+    Result.quotient.assign(n - m + 1, 0);
+    for (size_t j = n - m + 1; j-- > 0;)
+    {
+        long long numerator = u[j + m] * DIGIT_BASE + u[j + m - 1];
+        long long qhat = numerator / v[m - 1], rhat = numerator % v[m - 1];
+        while (qhat >= DIGIT_BASE || qhat * v[m - 2] > rhat * DIGIT_BASE + u[j + m - 2])
+        {
+            qhat--;
+            rhat += v[m - 1];
+            if (rhat >= DIGIT_BASE)
+                break;
+        }
+        long long borrow = 0;
+        carry = 0;
+        for (size_t i = 0; i < m; i++)
+        {
+            long long product = qhat * v[i] + carry;
+            carry = product / DIGIT_BASE;
+            long long difference = u[i + j] - product % DIGIT_BASE - borrow;
+            borrow = difference < 0;
+            u[i + j] = difference + (borrow ? DIGIT_BASE : 0);
+        }
+        u[j + m] -= carry + borrow;
+        if (u[j + m] < 0)
+        {
+            qhat--;
+            carry = 0;
+            for (size_t i = 0; i < m; i++)
+            {
+                long long sum = u[i + j] + v[i] + carry;
+                u[i + j] = sum % DIGIT_BASE;
+                carry = sum / DIGIT_BASE;
+            }
+            u[j + m] += carry;
+        }
+        Result.quotient[j] = (int)qhat;
+    }
+    while (!Result.quotient.empty() && Result.quotient.back() == 0)
+        Result.quotient.pop_back();
+    Result.remainder.assign(m, 0);
+    long long remainder = 0;
+    for (size_t i = m; i-- > 0;)
+    {
+        long long value = remainder * DIGIT_BASE + u[i];
+        Result.remainder[i] = (int)(value / factor);
+        remainder = value % factor;
+    }
+    while (!Result.remainder.empty() && Result.remainder.back() == 0)
+        Result.remainder.pop_back();
+    return Result;
+}
+
+DigitDivisionResult LargeNumberArithmetic::divideDigitsNewton(const std::vector<int> &dividend, const std::vector<int> &divisor)
+{
+    OperationStats::count(STAT_DIVIDE_NEWTON);
+    DigitDivisionResult Result;
+    size_t m = divisor.size();
+    if (dividend.size() + 2 < 2 * m)
+    {
+        size_t drop = 2 * m - dividend.size() - 2;
+        Result.quotient = divideDigits(shiftDigitsRight(dividend, drop), shiftDigitsRight(divisor, drop)).quotient;
+        std::vector<int> product = multiplyDigits(Result.quotient, divisor);
+        while (compareDigits(product, dividend) > 0)
+        {
+            Result.quotient = subtractDigits(Result.quotient, {1});
+            product = subtractDigits(product, divisor);
+        }
+        Result.remainder = subtractDigits(dividend, product);
+        while (compareDigits(Result.remainder, divisor) >= 0)
+        {
+            Result.remainder = subtractDigits(Result.remainder, divisor);
+            Result.quotient = addDigits(Result.quotient, {1});
+        }
+        return Result;
+    }
+    std::vector<int> reciprocal = reciprocalDigits(divisor);
+    std::vector<int> remaining = dividend;
+    while (compareDigits(remaining, divisor) >= 0)
+    {
+        size_t shift = remaining.size() > 2 * m ? remaining.size() - 2 * m : 0;
+        std::vector<int> high(remaining.begin() + shift, remaining.end()), low(remaining.begin(), remaining.begin() + shift);
+        std::vector<int> quotient = shiftDigitsRight(multiplyDigits(high, reciprocal), 2 * m);
+        std::vector<int> remainder = subtractDigits(high, multiplyDigits(quotient, divisor));
+        while (compareDigits(remainder, divisor) >= 0)
+        {
+            remainder = subtractDigits(remainder, divisor);
+            quotient = addDigits(quotient, {1});
+        }
+        Result.quotient = addDigits(Result.quotient, shiftDigitsLeft(quotient, shift));
+        remaining = addDigits(shiftDigitsLeft(remainder, shift), low);
+    }
+    while (!remaining.empty() && remaining.back() == 0)
+        remaining.pop_back();
+    Result.remainder = remaining;
+    return Result;
+}
+
+DigitDivisionResult LargeNumberArithmetic::divideDigits(DigitSpan dividend, DigitSpan divisor)
+{
+    while (!dividend.empty() && dividend.back() == 0)
+        dividend.length--;
+    while (!divisor.empty() && divisor.back() == 0)
+        divisor.length--;
+    if (divisor.empty())
+        throw("Arithmetic Error: Division By 0");
+    if (divisor.size() > thresholds().newtonDivision && dividend.size() >= divisor.size() + thresholds().newtonDivision)
+        return divideDigitsNewton(std::vector<int>(dividend.begin(), dividend.end()), std::vector<int>(divisor.begin(), divisor.end()));
+    return divideDigitsSchoolbook(dividend, divisor);
+}
@@ -0,0 +1,46 @@
+#include "rsa_bignum/LargeNumberChecking.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include "rsa_bignum/LargeNumberSpecialOperations.h"
+#include "rsa_bignum/LatencyHistograms.h"
+#include "rsa_bignum/Trace.h"
+
+bool LargeNumberChecking::isPrimeNumber(const LargeNumber &inputNumber)
+{
+    TraceSpan Span("LargeNumberChecking::isPrimeNumber", "arithmetic");
+    LatencyTimer Latency(LATENCY_PRIMALITY_CHECK);
+    LargeNumber number = LargeNumberConversion::copyLargeNumber(inputNumber);
+    LargeNumber one, two, base, numberMinusOne, oddPart, exponentK, calcResult, remainder;
+    one.digits[0] = 1;
+    two.digits[0] = 2;
+    base.digits[0] = 2;
+    if (LargeNumberArithmetic::subtractLargeNumbers(number, base).is_negative)
+        return false;
+    DivisionResult divisionResult = LargeNumberArithmetic::divideByLargeNumber(number, two);
+    if (LargeNumberConversion::isEqualToZero(divisionResult.remainder))
+        return false;
+    numberMinusOne = LargeNumberArithmetic::subtractLargeNumbers(number, one);
+    oddPart = numberMinusOne;
+    exponentK.digits[0] = 0;
+    while (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::divideByLargeNumber(oddPart, two).remainder))
+    {
+        oddPart = LargeNumberArithmetic::divideByLargeNumber(oddPart, two).quotient;
+        exponentK = LargeNumberArithmetic::addLargeNumbers(exponentK, one);
+    }
+    calcResult = LargeNumberSpecialOperations::modularExponentiation(base, oddPart, number);
+    divisionResult = LargeNumberArithmetic::divideByLargeNumber(calcResult, number);
+    if (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(divisionResult.remainder, one)) ||
+        LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(divisionResult.remainder, numberMinusOne)))
+        return true;
+    LargeNumber currentExponent = one;
+    while (!LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(exponentK, currentExponent)))
+    {
+        calcResult = LargeNumberSpecialOperations::modularExponentiation(calcResult, two, number);
+        divisionResult = LargeNumberArithmetic::divideByLargeNumber(calcResult, number);
+        if (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(divisionResult.remainder, one)))
+            return false;
+        if (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(divisionResult.remainder, numberMinusOne)))
+            return true;
+        currentExponent = LargeNumberArithmetic::addLargeNumbers(currentExponent, one);
+    }
+    return false;
+}
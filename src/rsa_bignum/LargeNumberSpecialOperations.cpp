@@ -0,0 +1,127 @@
+#include "rsa_bignum/LargeNumberSpecialOperations.h"
+#include "rsa_bignum/ArithmeticBackend.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include "rsa_bignum/LatencyHistograms.h"
+#include "rsa_bignum/OperationStats.h"
+#include "rsa_bignum/Trace.h"
+
+LargeNumber LargeNumberSpecialOperations::modularExponentiation(const LargeNumber &base, const LargeNumber &exponent, const LargeNumber &modulus)
+{
+    OperationStats::count(STAT_MODULAR_EXPONENTIATION);
+    if (LargeNumberConversion::isEqualToZero(base))
+        return base;
+    std::vector<int> exponentDigits = LargeNumberConversion::toDigitVector(exponent);
+    if (exponentDigits.empty())
+        return LargeNumberConversion::fromDigitVector({1});
+    std::vector<int> Result = ArithmeticBackend::powerModulo(LargeNumberConversion::toDigitVector(base), exponentDigits, LargeNumberConversion::toDigitVector(modulus));
+    return LargeNumberConversion::fromDigitVector(Result, base.is_negative && exponentDigits[0] % 2 == 1 && !Result.empty());
+}
+
+LargeNumber LargeNumberSpecialOperations::inverse(LargeNumber number, LargeNumber modulus)
+{
+    TraceSpan Span("LargeNumberSpecialOperations::inverse", "arithmetic");
+    LatencyTimer Latency(LATENCY_INVERSE);
+    OperationStats::count(STAT_INVERSE);
+    LargeNumber Result, Q, A2, A3, B2, B3, T2, T3, Zero, One, temp;
+    One.digits[0] = 1;
+    A2 = LargeNumberConversion::copyLargeNumber(Zero);
+    A3 = LargeNumberConversion::copyLargeNumber(modulus);
+    B2 = LargeNumberConversion::copyLargeNumber(One);
+    B3 = LargeNumberConversion::copyLargeNumber(number);
+    while (!LargeNumberConversion::isEqualToZero(B3) && !LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(B3, One)))
+    {
+        Q = LargeNumberArithmetic::divideByLargeNumber(A3, B3).quotient;
+        T2 = LargeNumberArithmetic::subtractLargeNumbers(A2, LargeNumberArithmetic::multiplyLargeNumbers(Q, B2));
+        T3 = LargeNumberArithmetic::subtractLargeNumbers(A3, LargeNumberArithmetic::multiplyLargeNumbers(Q, B3));
+        A2 = LargeNumberConversion::copyLargeNumber(B2);
+        A3 = LargeNumberConversion::copyLargeNumber(B3);
+        B2 = LargeNumberConversion::copyLargeNumber(T2);
+        B3 = LargeNumberConversion::copyLargeNumber(T3);
+    }
+    if (LargeNumberConversion::isEqualToZero(B3))
+    {
+        LargeNumber res;
+        res.is_negative = true;
+        res.digits[0] = 1;
+        return res;
+    }
+    if (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(B3, One)))
+    {
+        while (B2.is_negative)
+            B2 = LargeNumberArithmetic::addLargeNumbers(B2, modulus);
+        Result = B2;
+        temp = LargeNumberArithmetic::subtractLargeNumbers(Result, modulus);
+        while (!temp.is_negative)
+        {
+            Result = temp;
+            temp = LargeNumberArithmetic::subtractLargeNumbers(Result, modulus);
+        }
+    }
+    return Result;
+}
+
+std::vector<LargeNumber> LargeNumberSpecialOperations::batchInverse(const std::vector<LargeNumber> &numbers, const LargeNumber &modulus)
+{
+    TraceSpan Span("LargeNumberSpecialOperations::batchInverse", "arithmetic");
+    std::vector<LargeNumber> Result(numbers.size());
+    if (numbers.empty())
+        return Result;
+    std::vector<LargeNumber> Prefix(numbers.size());
+    Prefix[0] = reduceModulo(numbers[0], modulus);
+    for (size_t i = 1; i < numbers.size(); ++i)
+        Prefix[i] = reduceModulo(LargeNumberArithmetic::multiplyLargeNumbers(Prefix[i - 1], numbers[i]), modulus);
+    LargeNumber Accumulator = inverse(Prefix.back(), modulus);
+    if (Accumulator.is_negative || LargeNumberConversion::isEqualToZero(Accumulator))
+    {
+        for (size_t i = 0; i < numbers.size(); ++i)
+            Result[i] = inverse(reduceModulo(numbers[i], modulus), modulus);
+        return Result;
+    }
+    for (size_t i = numbers.size() - 1; i > 0; --i)
+    {
+        Result[i] = reduceModulo(LargeNumberArithmetic::multiplyLargeNumbers(Accumulator, Prefix[i - 1]), modulus);
+        Accumulator = reduceModulo(LargeNumberArithmetic::multiplyLargeNumbers(Accumulator, numbers[i]), modulus);
+    }
+    Result[0] = Accumulator;
+    return Result;
+}
+
+LargeNumber LargeNumberSpecialOperations::reduceModulo(const LargeNumber &number, const LargeNumber &modulus)
+{
+    LargeNumber Result = LargeNumberArithmetic::divideByLargeNumber(number, modulus).remainder;
+    if (!Result.is_negative)
+        return Result;
+    Result.is_negative = false;
+    if (LargeNumberConversion::isEqualToZero(Result))
+        return Result;
+    return LargeNumberArithmetic::subtractLargeNumbers(modulus, Result);
+}
+
+LargeNumber LargeNumberSpecialOperations::greatestCommonDivisor(LargeNumber first, LargeNumber second)
+{
+    OperationStats::count(STAT_GREATEST_COMMON_DIVISOR);
+    first.is_negative = second.is_negative = false;
+    while (!LargeNumberConversion::isEqualToZero(second))
+    {
+        LargeNumber temp = LargeNumberArithmetic::divideByLargeNumber(first, second).remainder;
+        first = second;
+        second = temp;
+    }
+    return first;
+}
+
+LargeNumber LargeNumberSpecialOperations::decryptMultiPrime(const LargeNumber &ciphertext, const std::vector<LargeNumber> &primes, const std::vector<LargeNumber> &exponents, const std::vector<LargeNumber> &coefficients)
+{
+    LargeNumber Result, Product;
+    Product.digits[0] = 1;
+    for (size_t i = 0; i < primes.size(); ++i)
+    {
+        const LargeNumber &Prime = primes[i];
+        LargeNumber Residue = modularExponentiation(reduceModulo(ciphertext, Prime), exponents[i], Prime);
+        LargeNumber Difference = reduceModulo(LargeNumberArithmetic::subtractLargeNumbers(Residue, Result), Prime);
+        LargeNumber H = reduceModulo(LargeNumberArithmetic::multiplyLargeNumbers(Difference, coefficients[i]), Prime);
+        Result = LargeNumberArithmetic::addLargeNumbers(Result, LargeNumberArithmetic::multiplyLargeNumbers(Product, H));
+        Product = LargeNumberArithmetic::multiplyLargeNumbers(Product, Prime);
+    }
+    return Result;
+}
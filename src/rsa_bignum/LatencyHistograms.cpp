@@ -0,0 +1,157 @@
+#include "rsa_bignum/LatencyHistograms.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    const int SUB_BUCKET_BITS = 6;
+    const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    const int BUCKET_COUNT = (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    struct Histogram
+    {
+        std::atomic<unsigned long long> buckets[BUCKET_COUNT];
+        std::atomic<unsigned long long> total;
+        std::atomic<long long> maximum;
+    };
+
+    Histogram Histograms[LATENCY_OPERATION_COUNT];
+
+    std::mutex ReporterMutex;
+    std::condition_variable ReporterWake;
+    std::thread Reporter;
+    bool ReporterStopping = false;
+
+    int bucketIndex(unsigned long long value)
+    {
+        if (value < 2 * SUB_BUCKETS)
+            return int(value);
+        int shift = 64 - __builtin_clzll(value) - SUB_BUCKET_BITS - 1;
+        return (shift + 1) * SUB_BUCKETS + int(value >> shift) - SUB_BUCKETS;
+    }
+
+    long long bucketUpperBound(int index)
+    {
+        if (index < 2 * SUB_BUCKETS)
+            return index;
+        int shift = index / SUB_BUCKETS - 1;
+        unsigned long long mantissa = index % SUB_BUCKETS + SUB_BUCKETS;
+        return (long long)(((mantissa + 1) << shift) - 1);
+    }
+}
+
+long long LatencyHistograms::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void LatencyHistograms::record(LatencyOperation operation, long long nanoseconds, unsigned long long count)
+{
+    Histogram &histogram = Histograms[operation];
+    if (nanoseconds < 0)
+        nanoseconds = 0;
+    histogram.buckets[bucketIndex(nanoseconds)].fetch_add(count, std::memory_order_relaxed);
+    histogram.total.fetch_add(count, std::memory_order_relaxed);
+    long long previous = histogram.maximum.load(std::memory_order_relaxed);
+    while (previous < nanoseconds && !histogram.maximum.compare_exchange_weak(previous, nanoseconds, std::memory_order_relaxed))
+        ;
+}
+
+unsigned long long LatencyHistograms::count(LatencyOperation operation)
+{
+    return Histograms[operation].total.load(std::memory_order_relaxed);
+}
+
+long long LatencyHistograms::percentile(LatencyOperation operation, double fraction)
+{
+    const Histogram &histogram = Histograms[operation];
+    unsigned long long total = histogram.total.load(std::memory_order_relaxed);
+    if (!total)
+        return 0;
+    unsigned long long rank = (unsigned long long)(fraction * total + 0.5), seen = 0;
+    if (rank < 1)
+        rank = 1;
+    long long maximum = histogram.maximum.load(std::memory_order_relaxed);
+    for (int index = 0; index < BUCKET_COUNT; ++index)
+    {
+        seen += histogram.buckets[index].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(bucketUpperBound(index), maximum);
+    }
+    return maximum;
+}
+
+const char *LatencyHistograms::name(LatencyOperation operation)
+{
+    static const char *NAMES[LATENCY_OPERATION_COUNT] = {
+        "primality_check", "base_reduction", "encryption", "ciphertext_match", "inverse", "key_group", "greatest_common_divisor"};
+    return NAMES[operation];
+}
+
+void LatencyHistograms::print(std::ostream &output)
+{
+    output << "latency percentiles (us):" << std::endl;
+    output << "  " << std::left << std::setw(26) << "operation" << std::right << std::setw(12) << "count" << std::setw(14) << "p50"
+           << std::setw(14) << "p99" << std::setw(14) << "p999" << std::setw(14) << "max" << std::endl;
+    output << std::fixed << std::setprecision(1);
+    for (int operation = 0; operation < LATENCY_OPERATION_COUNT; ++operation)
+    {
+        LatencyOperation current = LatencyOperation(operation);
+        if (!count(current))
+            continue;
+        output << "  " << std::left << std::setw(26) << name(current) << std::right << std::setw(12) << count(current)
+               << std::setw(14) << percentile(current, 0.50) / 1000.0 << std::setw(14) << percentile(current, 0.99) / 1000.0
+               << std::setw(14) << percentile(current, 0.999) / 1000.0 << std::setw(14) << Histograms[operation].maximum.load() / 1000.0 << std::endl;
+    }
+    output << std::defaultfloat;
+}
+
+void LatencyHistograms::startReporter(std::ostream &output, unsigned seconds)
+{
+    if (!seconds || Reporter.joinable())
+        return;
+    static bool registered = std::atexit(stopReporter) == 0;
+    (void)registered;
+    ReporterStopping = false;
+    Reporter = std::thread([&output, seconds]()
+    {
+        std::unique_lock<std::mutex> lock(ReporterMutex);
+        while (!ReporterWake.wait_for(lock, std::chrono::seconds(seconds), []() { return ReporterStopping; }))
+            print(output);
+    });
+}
+
+void LatencyHistograms::stopReporter()
+{
+    if (!Reporter.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(ReporterMutex);
+        ReporterStopping = true;
+    }
+    ReporterWake.notify_all();
+    Reporter.join();
+}
+
+LatencyTimer::LatencyTimer(LatencyOperation operation) : operation(operation), start(-1)
+{
+    if (LatencyHistograms::enabled)
+        start = LatencyHistograms::now();
+}
+
+LatencyTimer::~LatencyTimer()
+{
+    if (start >= 0)
+        LatencyHistograms::record(operation, LatencyHistograms::now() - start);
+}
+
+long long LatencyTimer::elapsed() const
+{
+    return start >= 0 ? LatencyHistograms::now() - start : 0;
+}
@@ -0,0 +1,268 @@
+#include "rsa_bignum/LimbKernels.h"
+#include <algorithm>
+#include <chrono>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#include <cpuid.h>
+#endif
+
+bool LimbKernels::supportsMulxAdx()
+{
+#if defined(__x86_64__)
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (ebx & bit_BMI2) && (ebx & bit_ADX);
+#else
+    return false;
+#endif
+}
+
+LimbKernelTable LimbKernels::portableKernels()
+{
+    return {"portable", multiplyLimbPortable, addMultiplyLimbPortable, multiplyCombaPortable, reduceMontgomeryPortable};
+}
+
+LimbKernelTable LimbKernels::mulxAdxKernels()
+{
+    return {"mulx-adx", multiplyLimbMulxAdx, addMultiplyLimbMulxAdx, multiplyCombaMulxAdx, reduceMontgomeryMulxAdx};
+}
+
+LimbKernelTable LimbKernels::detectKernels()
+{
+    return supportsMulxAdx() ? mulxAdxKernels() : portableKernels();
+}
+
+LimbKernelTable &LimbKernels::activeKernels()
+{
+    static LimbKernelTable kernels = detectKernels();
+    return kernels;
+}
+
+bool LimbKernels::parseKernels(const std::string &name, LimbKernelTable &kernels)
+{
+    if (name == "portable")
+        kernels = portableKernels();
+    else if (name == "mulx-adx" && supportsMulxAdx())
+        kernels = mulxAdxKernels();
+    else
+        return false;
+    return true;
+}
+
+unsigned long long LimbKernels::readCycleCounter()
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+unsigned long long LimbKernels::multiplyLimbPortable(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result)
+{
+    unsigned long long carry = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        unsigned __int128 value = (unsigned __int128)source[i] * factor + carry;
+        result[i] = (unsigned long long)value;
+        carry = (unsigned long long)(value >> 64);
+    }
+    return carry;
+}
+
+unsigned long long LimbKernels::addMultiplyLimbPortable(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result)
+{
+    unsigned long long carry = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        unsigned __int128 value = (unsigned __int128)source[i] * factor + result[i] + carry;
+        result[i] = (unsigned long long)value;
+        carry = (unsigned long long)(value >> 64);
+    }
+    return carry;
+}
+
+void LimbKernels::multiplyCombaPortable(const unsigned long long *first, const unsigned long long *second, size_t size, unsigned long long *result)
+{
+    unsigned __int128 accumulator = 0;
+    unsigned long long overflow = 0;
+    for (size_t k = 0; k + 1 < 2 * size; k++)
+    {
+        for (size_t i = k < size ? 0 : k - size + 1; i <= k && i < size; i++)
+        {
+            unsigned __int128 product = (unsigned __int128)first[i] * second[k - i];
+            accumulator += product;
+            overflow += accumulator < product;
+        }
+        result[k] = (unsigned long long)accumulator;
+        accumulator = (accumulator >> 64) | ((unsigned __int128)overflow << 64);
+        overflow = 0;
+    }
+    result[2 * size - 1] = (unsigned long long)accumulator;
+}
+
+void LimbKernels::reduceMontgomeryPortable(unsigned long long *product, const MontgomeryModulus &modulus, unsigned long long *result)
+{
+    const size_t size = modulus.size;
+    unsigned long long overflow = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        unsigned long long carry = addMultiplyLimbPortable(modulus.limbs.data(), size, product[i] * modulus.inverse, product + i);
+        unsigned __int128 top = (unsigned __int128)product[i + size] + carry + overflow;
+        product[i + size] = (unsigned long long)top;
+        overflow = (unsigned long long)(top >> 64);
+    }
+    subtractModulus(product + size, overflow, modulus, result);
+}
+
+#if defined(__x86_64__)
+unsigned long long LimbKernels::multiplyLimbMulxAdx(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result)
+{
+    unsigned long long high = 0, low, next;
+    long long index = -(long long)size;
+    __asm__("xor %k[low], %k[low]\n\t"
+            "1:\n\t"
+            "jrcxz 3f\n\t"
+            "mulx (%[source],%%rcx,8), %[low], %[next]\n\t"
+            "adcx %[high], %[low]\n\t"
+            "mov %[low], (%[result],%%rcx,8)\n\t"
+            "lea 1(%%rcx), %%rcx\n\t"
+            "jrcxz 2f\n\t"
+            "mulx (%[source],%%rcx,8), %[low], %[high]\n\t"
+            "adcx %[next], %[low]\n\t"
+            "mov %[low], (%[result],%%rcx,8)\n\t"
+            "lea 1(%%rcx), %%rcx\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "mov %[next], %[high]\n\t"
+            "3:\n\t"
+            "mov $0, %k[low]\n\t"
+            "adcx %[low], %[high]\n\t"
+            : [high] "+&r"(high), [low] "=&r"(low), [next] "=&r"(next), "+c"(index)
+            : [source] "r"(source + size), [result] "r"(result + size), "d"(factor)
+            : "cc", "memory");
+    return high;
+}
+
+unsigned long long LimbKernels::addMultiplyLimbMulxAdx(const unsigned long long *source, size_t size, unsigned long long factor, unsigned long long *result)
+{
+    unsigned long long high = 0, low, next;
+    long long index = -(long long)size;
+    __asm__("xor %k[low], %k[low]\n\t"
+            "1:\n\t"
+            "jrcxz 3f\n\t"
+            "mulx (%[source],%%rcx,8), %[low], %[next]\n\t"
+            "adcx %[high], %[low]\n\t"
+            "adox (%[result],%%rcx,8), %[low]\n\t"
+            "mov %[low], (%[result],%%rcx,8)\n\t"
+            "lea 1(%%rcx), %%rcx\n\t"
+            "jrcxz 2f\n\t"
+            "mulx (%[source],%%rcx,8), %[low], %[high]\n\t"
+            "adcx %[next], %[low]\n\t"
+            "adox (%[result],%%rcx,8), %[low]\n\t"
+            "mov %[low], (%[result],%%rcx,8)\n\t"
+            "lea 1(%%rcx), %%rcx\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "mov %[next], %[high]\n\t"
+            "3:\n\t"
+            "mov $0, %k[low]\n\t"
+            "adcx %[low], %[high]\n\t"
+            "adox %[low], %[high]\n\t"
+            : [high] "+&r"(high), [low] "=&r"(low), [next] "=&r"(next), "+c"(index)
+            : [source] "r"(source + size), [result] "r"(result + size), "d"(factor)
+            : "cc", "memory");
+    return high;
+}
+
+void LimbKernels::multiplyCombaMulxAdx(const unsigned long long *first, const unsigned long long *second, size_t size, unsigned long long *result)
+{
+    static const unsigned long long zero = 0;
+    unsigned long long even0 = 0, even1 = 0, even2 = 0;
+    for (size_t k = 0; k + 1 < 2 * size; k++)
+    {
+        size_t start = k < size ? 0 : k - size + 1, end = std::min(k + 1, size);
+        unsigned long long odd0 = 0, odd1 = 0, odd2 = 0, low, high;
+        const unsigned long long *firstLimb = first + start, *secondLimb = second + k - start;
+        size_t count = end - start;
+        __asm__("xor %k[low], %k[low]\n\t"
+                "1:\n\t"
+                "mov (%[first]), %%rdx\n\t"
+                "mulx (%[second]), %[low], %[high]\n\t"
+                "adcx %[low], %[even0]\n\t"
+                "adcx %[high], %[even1]\n\t"
+                "adcx %[zero], %[even2]\n\t"
+                "lea -1(%%rcx), %%rcx\n\t"
+                "jrcxz 2f\n\t"
+                "mov 8(%[first]), %%rdx\n\t"
+                "mulx -8(%[second]), %[low], %[high]\n\t"
+                "adox %[low], %[odd0]\n\t"
+                "adox %[high], %[odd1]\n\t"
+                "adox %[zero], %[odd2]\n\t"
+                "lea 16(%[first]), %[first]\n\t"
+                "lea -16(%[second]), %[second]\n\t"
+                "lea -1(%%rcx), %%rcx\n\t"
+                "jrcxz 2f\n\t"
+                "jmp 1b\n\t"
+                "2:\n\t"
+                : [even0] "+&r"(even0), [even1] "+&r"(even1), [even2] "+&r"(even2), [odd0] "+&r"(odd0), [odd1] "+&r"(odd1), [odd2] "+&r"(odd2), [low] "=&r"(low), [high] "=&r"(high), [first] "+&r"(firstLimb), [second] "+&r"(secondLimb), "+c"(count)
+                : [zero] "m"(zero)
+                : "rdx", "cc", "memory");
+        unsigned __int128 column = (unsigned __int128)even0 + odd0;
+        result[k] = (unsigned long long)column;
+        column = (column >> 64) + even1 + odd1;
+        even0 = (unsigned long long)column;
+        even1 = (unsigned long long)(column >> 64) + even2 + odd2;
+        even2 = 0;
+    }
+    result[2 * size - 1] = even0;
+}
+
+void LimbKernels::reduceMontgomeryMulxAdx(unsigned long long *product, const MontgomeryModulus &modulus, unsigned long long *result)
+{
+    const size_t size = modulus.size;
+    unsigned long long overflow = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        unsigned long long carry = addMultiplyLimbMulxAdx(modulus.limbs.data(), size, product[i] * modulus.inverse, product + i);
+        unsigned __int128 top = (unsigned __int128)product[i + size] + carry + overflow;
+        product[i + size] = (unsigned long long)top;
+        overflow = (unsigned long long)(top >> 64);
+    }
+    subtractModulus(product + size, overflow, modulus, result);
+}
+#else
+unsigned long long LimbKernels::multiplyLimbMulxAdx(const unsigned long long *, size_t, unsigned long long, unsigned long long *)
+{
+    throw("Kernel Error: MULX/ADX Unavailable");
+}
+
+unsigned long long LimbKernels::addMultiplyLimbMulxAdx(const unsigned long long *, size_t, unsigned long long, unsigned long long *)
+{
+    throw("Kernel Error: MULX/ADX Unavailable");
+}
+
+void LimbKernels::multiplyCombaMulxAdx(const unsigned long long *, const unsigned long long *, size_t, unsigned long long *)
+{
+    throw("Kernel Error: MULX/ADX Unavailable");
+}
+
+void LimbKernels::reduceMontgomeryMulxAdx(unsigned long long *, const MontgomeryModulus &, unsigned long long *)
+{
+    throw("Kernel Error: MULX/ADX Unavailable");
+}
+#endif
+
+void LimbKernels::subtractModulus(const unsigned long long *value, unsigned long long overflow, const MontgomeryModulus &modulus, unsigned long long *result)
+{
+    unsigned long long borrow = 0;
+    for (size_t j = 0; j < modulus.size; j++)
+    {
+        unsigned __int128 difference = (unsigned __int128)value[j] - modulus.limbs[j] - borrow;
+        result[j] = (unsigned long long)difference;
+        borrow = (unsigned long long)(difference >> 64) & 1;
+    }
+    if (overflow == 0 && borrow != 0)
+        std::copy(value, value + modulus.size, result);
+}
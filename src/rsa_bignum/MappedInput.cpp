@@ -0,0 +1,165 @@
+#include "rsa_bignum/MappedInput.h"
+#include <charconv>
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace
+{
+    bool isSpace(char character)
+    {
+        return character == ' ' || character == '\n' || character == '\r' || character == '\t' || character == '\v' || character == '\f';
+    }
+}
+
+MappedInput::MappedInput() : data(nullptr), size(0), position(0), mapped(false), binary(false), negative(false), type(RecordType(0)), count(0)
+{
+}
+
+MappedInput::~MappedInput()
+{
+#if defined(__unix__)
+    if (mapped)
+        munmap(const_cast<char *>(data), size);
+#endif
+}
+
+bool MappedInput::open(const std::string &path)
+{
+#if defined(__unix__)
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+    struct stat status;
+    if (fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0)
+    {
+        void *address = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address != MAP_FAILED)
+        {
+            madvise(address, status.st_size, MADV_SEQUENTIAL);
+            close(descriptor);
+            data = static_cast<const char *>(address);
+            size = status.st_size;
+            mapped = true;
+            binary = BinaryFormat::readHeader(contents(), type, count);
+            position = binary ? BinaryFormat::HEADER_SIZE : 0;
+            return true;
+        }
+    }
+    char chunk[1 << 16];
+    ssize_t bytesRead;
+    while ((bytesRead = read(descriptor, chunk, sizeof(chunk))) > 0)
+        buffer.append(chunk, bytesRead);
+    close(descriptor);
+    if (bytesRead < 0)
+        return false;
+#else
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open())
+        return false;
+    buffer.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+#endif
+    data = buffer.data();
+    size = buffer.size();
+    binary = BinaryFormat::readHeader(contents(), type, count);
+    position = binary ? BinaryFormat::HEADER_SIZE : 0;
+    return true;
+}
+
+bool MappedInput::isMapped() const
+{
+    return mapped;
+}
+
+bool MappedInput::isBinary() const
+{
+    return binary;
+}
+
+bool MappedInput::isNegative() const
+{
+    return negative;
+}
+
+RecordType MappedInput::recordType() const
+{
+    return type;
+}
+
+bool MappedInput::matchesRecordType(RecordType expected) const
+{
+    return !binary || type == expected;
+}
+
+unsigned long long MappedInput::recordCount() const
+{
+    return count;
+}
+
+std::string_view MappedInput::contents() const
+{
+    return std::string_view(data, size);
+}
+
+std::string_view MappedInput::next()
+{
+    std::string_view token;
+    if (binary)
+        return next(token) ? token : std::string_view();
+    while (position < size && isSpace(data[position]))
+        ++position;
+    size_t start = position;
+    while (position < size && !isSpace(data[position]))
+        ++position;
+    return std::string_view(data + start, position - start);
+}
+
+bool MappedInput::next(int &value)
+{
+    std::string_view token;
+    if (binary)
+    {
+        if (!next(token))
+            return false;
+        value = int(BinaryFormat::toInteger(token, negative));
+        return true;
+    }
+    token = next();
+    return !token.empty() && std::from_chars(token.data(), token.data() + token.size(), value).ec == std::errc();
+}
+
+bool MappedInput::next(std::string_view &token)
+{
+    if (binary)
+        return BinaryFormat::readRecord(contents(), position, token, negative);
+    token = next();
+    return !token.empty();
+}
+
+size_t MappedInput::offset() const
+{
+    return position;
+}
+
+void MappedInput::seek(size_t offset)
+{
+    position = offset < size ? offset : size;
+}
+
+void MappedInput::discard(size_t end)
+{
+#if defined(__unix__)
+    if (!mapped)
+        return;
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t length = (end < size ? end : size) / page * page;
+    if (length)
+        madvise(const_cast<char *>(data), length, MADV_DONTNEED);
+#endif
+}
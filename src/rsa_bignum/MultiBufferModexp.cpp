@@ -0,0 +1,330 @@
+#include "rsa_bignum/MultiBufferModexp.h"
+#include "rsa_bignum/ConversionOperations.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include "rsa_bignum/LargeNumberSpecialOperations.h"
+#include "rsa_bignum/LatencyHistograms.h"
+#include "rsa_bignum/OperationStats.h"
+#include "rsa_bignum/Trace.h"
+#include <algorithm>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+MultiBufferModexp::Kernel MultiBufferModexp::detectKernel()
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma"))
+        return Kernel::Avx512Ifma;
+    if (__builtin_cpu_supports("avx2"))
+        return Kernel::Avx2;
+#endif
+    return Kernel::Scalar;
+}
+
+MultiBufferModexp::Kernel &MultiBufferModexp::activeKernel()
+{
+    static Kernel kernel = detectKernel();
+    return kernel;
+}
+
+bool MultiBufferModexp::parseKernel(const std::string &name, Kernel &kernel)
+{
+    Kernel available = detectKernel();
+    if (name == "scalar")
+        kernel = Kernel::Scalar;
+    else if (name == "avx2" && available != Kernel::Scalar)
+        kernel = Kernel::Avx2;
+    else if (name == "avx512ifma" && available == Kernel::Avx512Ifma)
+        kernel = Kernel::Avx512Ifma;
+    else
+        return false;
+    return true;
+}
+
+std::vector<int> MultiBufferModexp::powerOfTwo(size_t exponent)
+{
+    std::vector<int> Result = {1}, Base = {2};
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+            Result = LargeNumberArithmetic::multiplyDigits(Result, Base);
+        exponent >>= 1;
+        if (exponent > 0)
+            Base = LargeNumberArithmetic::multiplyDigits(Base, Base);
+    }
+    return Result;
+}
+
+std::vector<unsigned long long> MultiBufferModexp::toBinaryLimbs(const std::vector<int> &digits, unsigned bits, size_t count)
+{
+    const unsigned long long mask = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+    std::vector<unsigned long long> Result(count, 0);
+    for (size_t i = digits.size(); i-- > 0;)
+    {
+        unsigned __int128 carry = digits[i];
+        for (size_t j = 0; j < count; j++)
+        {
+            unsigned __int128 value = (unsigned __int128)Result[j] * LargeNumberArithmetic::DIGIT_BASE + carry;
+            Result[j] = (unsigned long long)value & mask;
+            carry = value >> bits;
+        }
+    }
+    return Result;
+}
+
+std::string MultiBufferModexp::binaryLimbsToHex(const std::vector<unsigned long long> &limbs, unsigned bits)
+{
+    std::string res;
+    for (size_t position = 0; position < limbs.size() * bits; position += 4)
+    {
+        int nibble = 0;
+        for (unsigned bit = 0; bit < 4; ++bit)
+        {
+            size_t index = (position + bit) / bits;
+            if (index < limbs.size() && (limbs[index] >> ((position + bit) % bits)) & 1)
+                nibble |= 1 << bit;
+        }
+        res.push_back("0123456789ABCDEF"[nibble]);
+    }
+    while (res.size() > 1 && res.back() == '0')
+        res.pop_back();
+    std::reverse(res.begin(), res.end());
+    return res.empty() ? "0" : res;
+}
+
+MontgomeryModulus MultiBufferModexp::buildModulus(const std::vector<int> &modulus, unsigned bits)
+{
+    MontgomeryModulus Result;
+    Result.bits = bits;
+    Result.mask = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+    Result.limbs = toBinaryLimbs(modulus, bits, (modulus.size() * 7 + bits - 1) / bits + 1);
+    while (Result.limbs.size() > 1 && Result.limbs.back() == 0)
+        Result.limbs.pop_back();
+    Result.size = Result.limbs.size();
+    unsigned long long Inverse = Result.limbs[0];
+    for (int i = 0; i < 6; i++)
+        Inverse *= 2 - Result.limbs[0] * Inverse;
+    Result.inverse = (0 - Inverse) & Result.mask;
+    Result.montgomeryOne = toBinaryLimbs(LargeNumberArithmetic::divideDigits(powerOfTwo(bits * Result.size), modulus).remainder, bits, Result.size);
+    Result.montgomerySquare = toBinaryLimbs(LargeNumberArithmetic::divideDigits(powerOfTwo(2 * bits * Result.size), modulus).remainder, bits, Result.size);
+    return Result;
+}
+
+void MultiBufferModexp::montgomeryMultiplyScalar(const unsigned long long *first, const unsigned long long *second, unsigned long long *result, const MontgomeryModulus &modulus, unsigned long long *scratch)
+{
+    const LimbKernelTable &kernels = LimbKernels::activeKernels();
+    kernels.multiplyComba(first, second, modulus.size, scratch);
+    kernels.reduceMontgomery(scratch, modulus, result);
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+void MultiBufferModexp::montgomeryMultiplyAvx2(const unsigned long long *first, const unsigned long long *second, unsigned long long *result, const MontgomeryModulus &modulus, unsigned long long *scratch)
+{
+    const size_t size = modulus.size;
+    const __m256i zero = _mm256_setzero_si256(), mask = _mm256_set1_epi64x(modulus.mask), inverse = _mm256_set1_epi64x(modulus.inverse);
+    std::fill(scratch, scratch + (2 * size + 1) * AVX2_LANES, 0);
+    auto t = [scratch](size_t index) { return (__m256i *)(scratch + index * AVX2_LANES); };
+    for (size_t i = 0; i < size; i++)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(first + i * AVX2_LANES));
+        __m256i low = _mm256_add_epi64(_mm256_loadu_si256(t(i)), _mm256_mul_epu32(a, _mm256_loadu_si256((const __m256i *)second)));
+        __m256i m = _mm256_and_si256(_mm256_mul_epu32(_mm256_and_si256(low, mask), inverse), mask);
+        low = _mm256_add_epi64(low, _mm256_mul_epu32(m, _mm256_set1_epi64x(modulus.limbs[0])));
+        for (size_t j = 1; j < size; j++)
+        {
+            __m256i b = _mm256_loadu_si256((const __m256i *)(second + j * AVX2_LANES));
+            __m256i n = _mm256_set1_epi64x(modulus.limbs[j]);
+            __m256i sum = _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_mul_epu32(m, n));
+            if (j == 1)
+                sum = _mm256_add_epi64(sum, _mm256_srli_epi64(low, modulus.bits));
+            _mm256_storeu_si256(t(i + j), _mm256_add_epi64(_mm256_loadu_si256(t(i + j)), sum));
+        }
+        if (size == 1)
+            _mm256_storeu_si256(t(i + 1), _mm256_add_epi64(_mm256_loadu_si256(t(i + 1)), _mm256_srli_epi64(low, modulus.bits)));
+    }
+    __m256i carry = zero, borrow = zero;
+    for (size_t j = 0; j < size; j++)
+    {
+        __m256i value = _mm256_add_epi64(_mm256_loadu_si256(t(size + j)), carry);
+        __m256i limb = _mm256_and_si256(value, mask);
+        carry = _mm256_srli_epi64(value, modulus.bits);
+        __m256i difference = _mm256_sub_epi64(_mm256_sub_epi64(limb, _mm256_set1_epi64x(modulus.limbs[j])), borrow);
+        borrow = _mm256_srli_epi64(difference, 63);
+        _mm256_storeu_si256(t(size + j), limb);
+        _mm256_storeu_si256(t(j), _mm256_and_si256(difference, mask));
+    }
+    __m256i useDifference = _mm256_or_si256(_mm256_cmpeq_epi64(borrow, zero), _mm256_cmpgt_epi64(carry, zero));
+    for (size_t j = 0; j < size; j++)
+        _mm256_storeu_si256((__m256i *)(result + j * AVX2_LANES), _mm256_blendv_epi8(_mm256_loadu_si256(t(size + j)), _mm256_loadu_si256(t(j)), useDifference));
+}
+
+__attribute__((target("avx512f,avx512ifma")))
+void MultiBufferModexp::montgomeryMultiplyAvx512Ifma(const unsigned long long *first, const unsigned long long *second, unsigned long long *result, const MontgomeryModulus &modulus, unsigned long long *scratch)
+{
+    const size_t size = modulus.size;
+    const __m512i zero = _mm512_set1_epi64(0), mask = _mm512_set1_epi64(modulus.mask), inverse = _mm512_set1_epi64(modulus.inverse);
+    std::fill(scratch, scratch + (2 * size + 1) * AVX512_LANES, 0);
+    auto t = [scratch](size_t index) { return scratch + index * AVX512_LANES; };
+    for (size_t i = 0; i < size; i++)
+    {
+        __m512i a = _mm512_loadu_si512(first + i * AVX512_LANES);
+        __m512i b = _mm512_loadu_si512(second);
+        __m512i n = _mm512_set1_epi64(modulus.limbs[0]);
+        __m512i low = _mm512_madd52lo_epu64(_mm512_loadu_si512(t(i)), a, b);
+        __m512i m = _mm512_and_si512(_mm512_madd52lo_epu64(zero, low, inverse), mask);
+        low = _mm512_madd52lo_epu64(low, m, n);
+        __m512i high = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(_mm512_loadu_si512(t(i + 1)), a, b), m, n);
+        high = _mm512_add_epi64(high, _mm512_maskz_srli_epi64(0xFF, low, modulus.bits));
+        for (size_t j = 1; j < size; j++)
+        {
+            b = _mm512_loadu_si512(second + j * AVX512_LANES);
+            n = _mm512_set1_epi64(modulus.limbs[j]);
+            _mm512_storeu_si512(t(i + j), _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(high, a, b), m, n));
+            high = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(_mm512_loadu_si512(t(i + j + 1)), a, b), m, n);
+        }
+        _mm512_storeu_si512(t(i + size), high);
+    }
+    __m512i carry = zero, borrow = zero;
+    for (size_t j = 0; j < size; j++)
+    {
+        __m512i value = _mm512_add_epi64(_mm512_loadu_si512(t(size + j)), carry);
+        __m512i limb = _mm512_and_si512(value, mask);
+        carry = _mm512_maskz_srli_epi64(0xFF, value, modulus.bits);
+        __m512i difference = _mm512_sub_epi64(_mm512_sub_epi64(limb, _mm512_set1_epi64(modulus.limbs[j])), borrow);
+        borrow = _mm512_maskz_srli_epi64(0xFF, difference, 63);
+        _mm512_storeu_si512(t(size + j), limb);
+        _mm512_storeu_si512(t(j), _mm512_and_si512(difference, mask));
+    }
+    __mmask8 useDifference = _mm512_cmpeq_epi64_mask(borrow, zero) | _mm512_cmpneq_epi64_mask(carry, zero);
+    for (size_t j = 0; j < size; j++)
+        _mm512_storeu_si512(result + j * AVX512_LANES, _mm512_mask_blend_epi64(useDifference, _mm512_loadu_si512(t(size + j)), _mm512_loadu_si512(t(j))));
+}
+#else
+void MultiBufferModexp::montgomeryMultiplyAvx2(const unsigned long long *, const unsigned long long *, unsigned long long *, const MontgomeryModulus &, unsigned long long *)
+{
+    throw("Kernel Error: AVX2 Unavailable");
+}
+
+void MultiBufferModexp::montgomeryMultiplyAvx512Ifma(const unsigned long long *, const unsigned long long *, unsigned long long *, const MontgomeryModulus &, unsigned long long *)
+{
+    throw("Kernel Error: AVX-512 IFMA Unavailable");
+}
+#endif
+
+std::vector<std::string> MultiBufferModexp::exponentiateLanes(const std::vector<std::vector<int>> &bases, const std::vector<unsigned long long> &exponent, const MontgomeryModulus &modulus, MultiplyKernel multiply)
+{
+    const size_t lanes = bases.size(), size = modulus.size;
+    std::vector<unsigned long long> base(size * lanes), square(size * lanes), accumulator(size * lanes), one(size * lanes, 0), scratch((2 * size + 1) * lanes);
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        std::vector<unsigned long long> limbs = toBinaryLimbs(bases[lane], modulus.bits, size);
+        for (size_t j = 0; j < size; ++j)
+        {
+            base[j * lanes + lane] = limbs[j];
+            square[j * lanes + lane] = modulus.montgomerySquare[j];
+            accumulator[j * lanes + lane] = modulus.montgomeryOne[j];
+        }
+        one[lane] = 1;
+    }
+    multiply(base.data(), square.data(), base.data(), modulus, scratch.data());
+    size_t bit = exponent.size() * 64;
+    while (bit > 0 && !((exponent[(bit - 1) / 64] >> ((bit - 1) % 64)) & 1))
+        --bit;
+    size_t multiplications = 0;
+    while (bit-- > 0)
+    {
+        multiply(accumulator.data(), accumulator.data(), accumulator.data(), modulus, scratch.data());
+        ++multiplications;
+        if ((exponent[bit / 64] >> (bit % 64)) & 1)
+        {
+            multiply(accumulator.data(), base.data(), accumulator.data(), modulus, scratch.data());
+            ++multiplications;
+        }
+    }
+    multiply(accumulator.data(), one.data(), accumulator.data(), modulus, scratch.data());
+    OperationStats::count(STAT_MONTGOMERY_MULTIPLY, lanes * (multiplications + 2));
+    std::vector<std::string> Result(lanes);
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        std::vector<unsigned long long> limbs(size);
+        for (size_t j = 0; j < size; ++j)
+            limbs[j] = accumulator[j * lanes + lane];
+        Result[lane] = binaryLimbsToHex(limbs, modulus.bits);
+    }
+    return Result;
+}
+
+MultiBufferModexp::Context MultiBufferModexp::prepare(const LargeNumber &exponent, const LargeNumber &modulus)
+{
+    TraceSpan Span("MultiBufferModexp::prepare", "arithmetic");
+    Context Result;
+    Result.exponent = exponent;
+    Result.modulus = modulus;
+    Result.modulusDigits = LargeNumberConversion::toDigitVector(modulus);
+    std::vector<int> exponentDigits = LargeNumberConversion::toDigitVector(exponent);
+    if (Result.modulusDigits.empty() || Result.modulusDigits[0] % 2 == 0 || exponentDigits.empty())
+        return Result;
+    Result.montgomery = true;
+    Result.exponentLimbs = toBinaryLimbs(exponentDigits, 64, (exponentDigits.size() * 7 + 63) / 64 + 1);
+    Result.scalarModulus = buildModulus(Result.modulusDigits, 64);
+    Kernel kernel = activeKernel();
+    if (kernel == Kernel::Avx512Ifma)
+    {
+        Result.vectorModulus = buildModulus(Result.modulusDigits, AVX512_LIMB_BITS);
+        Result.lanes = Result.vectorModulus.size < AVX512_MAX_LIMBS ? AVX512_LANES : 1;
+        Result.multiply = montgomeryMultiplyAvx512Ifma;
+    }
+    else if (kernel == Kernel::Avx2)
+    {
+        Result.vectorModulus = buildModulus(Result.modulusDigits, AVX2_LIMB_BITS);
+        Result.lanes = Result.vectorModulus.size < AVX2_MAX_LIMBS ? AVX2_LANES : 1;
+        Result.multiply = montgomeryMultiplyAvx2;
+    }
+    return Result;
+}
+
+std::vector<std::string> MultiBufferModexp::exponentiate(const Context &context, const std::vector<LargeNumber> &bases)
+{
+    TraceSpan Span("MultiBufferModexp::exponentiate", "arithmetic");
+    std::vector<std::string> Result;
+    if (!context.montgomery)
+    {
+        for (const auto &base : bases)
+        {
+            LatencyTimer Latency(LATENCY_ENCRYPTION);
+            Result.push_back(ConversionOperations::convertDecimalToHexBigEndian(LargeNumberSpecialOperations::modularExponentiation(base, context.exponent, context.modulus)));
+        }
+        return Result;
+    }
+    std::vector<std::vector<int>> reduced;
+    for (size_t i = 0; i < bases.size(); ++i)
+    {
+        TraceSpan Reduce("reduceBase", "message", i);
+        LatencyTimer Latency(LATENCY_BASE_REDUCTION);
+        reduced.push_back(LargeNumberArithmetic::divideDigits(LargeNumberConversion::toDigitVector(bases[i]), context.modulusDigits).remainder);
+    }
+    size_t lanes = context.lanes, done = 0;
+    for (; lanes > 1 && done + lanes <= reduced.size(); done += lanes)
+    {
+        TraceSpan Lanes("exponentiateLanes", "message", done);
+        long long start = LatencyHistograms::enabled ? LatencyHistograms::now() : 0;
+        std::vector<std::string> batch = exponentiateLanes(std::vector<std::vector<int>>(reduced.begin() + done, reduced.begin() + done + lanes), context.exponentLimbs, context.vectorModulus, context.multiply);
+        if (LatencyHistograms::enabled)
+            LatencyHistograms::record(LATENCY_ENCRYPTION, LatencyHistograms::now() - start, lanes);
+        Result.insert(Result.end(), batch.begin(), batch.end());
+    }
+    for (; done < reduced.size(); ++done)
+    {
+        TraceSpan Lane("exponentiateLanes", "message", done);
+        LatencyTimer Latency(LATENCY_ENCRYPTION);
+        Result.push_back(exponentiateLanes({reduced[done]}, context.exponentLimbs, context.scalarModulus, montgomeryMultiplyScalar)[0]);
+    }
+    return Result;
+}
+
+std::vector<std::string> MultiBufferModexp::exponentiateHex(const std::vector<LargeNumber> &bases, const LargeNumber &exponent, const LargeNumber &modulus)
+{
+    return exponentiate(prepare(exponent, modulus), bases);
+}
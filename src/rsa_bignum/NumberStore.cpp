@@ -0,0 +1,107 @@
+#include "rsa_bignum/NumberStore.h"
+#include "rsa_bignum/BinaryFormat.h"
+#include "rsa_bignum/Utils.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    const char MAGIC[8] = {'R', 'S', 'A', 'S', 'T', 'O', 'R', 'E'};
+    const uint64_t CHECKSUM_SEED = 14695981039346656037ULL;
+    const uint64_t CHECKSUM_PRIME = 1099511628211ULL;
+}
+
+LargeNumber NumberView::toLargeNumber() const
+{
+    return BinaryFormat::fromLimbs(limbs, size, negative);
+}
+
+BigInteger NumberView::toBigInteger() const
+{
+    return BigInteger(LargeNumberConversion::toDigitVector(toLargeNumber()));
+}
+
+NumberStore::NumberStore() : header(nullptr), index(nullptr), limbs(nullptr)
+{
+}
+
+bool NumberStore::isStore(std::string_view contents)
+{
+    return contents.size() >= sizeof(NumberStoreHeader) && std::memcmp(contents.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+uint64_t NumberStore::checksum(const unsigned long long *words, size_t count, uint64_t seed)
+{
+    uint64_t Result = seed;
+    for (size_t i = 0; i < count; ++i)
+        Result = (Result ^ words[i]) * CHECKSUM_PRIME;
+    return Result;
+}
+
+bool NumberStore::open(const std::string &path)
+{
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    return false;
+#endif
+    if (!file.open(path) || !isStore(file.contents()))
+        return false;
+    std::string_view contents = file.contents();
+    const NumberStoreHeader *candidate = reinterpret_cast<const NumberStoreHeader *>(contents.data());
+    if (candidate->version != VERSION || candidate->limbBits != 64 || candidate->limbsOffset % 8 || candidate->indexOffset % 8)
+        return false;
+    if (candidate->limbsOffset > contents.size() || candidate->indexOffset > contents.size())
+        return false;
+    const uint64_t total = candidate->count * candidate->width;
+    if (candidate->width && total / candidate->width != candidate->count)
+        return false;
+    if (total > (contents.size() - candidate->limbsOffset) / 8)
+        return false;
+    if (candidate->count > (contents.size() - candidate->indexOffset) / sizeof(NumberStoreEntry))
+        return false;
+    header = candidate;
+    index = reinterpret_cast<const NumberStoreEntry *>(contents.data() + header->indexOffset);
+    limbs = reinterpret_cast<const unsigned long long *>(contents.data() + header->limbsOffset);
+    for (size_t i = 0; i < header->count; ++i)
+        if (index[i].size > header->width || index[i].offset > total || index[i].size > total - index[i].offset)
+            return false;
+    return true;
+}
+
+bool NumberStore::verify() const
+{
+    if (!header)
+        return false;
+    uint64_t Result = checksum(limbs, header->count * header->width, CHECKSUM_SEED);
+    Result = checksum(reinterpret_cast<const unsigned long long *>(index), header->count * sizeof(NumberStoreEntry) / 8, Result);
+    return Result == header->checksum;
+}
+
+size_t NumberStore::size() const
+{
+    return header ? header->count : 0;
+}
+
+size_t NumberStore::width() const
+{
+    return header ? header->width : 0;
+}
+
+NumberView NumberStore::operator[](size_t position) const
+{
+    if (position >= size())
+        throw("Number Store Error: Index Out Of Range");
+    NumberView Result;
+    Result.limbs = limbs + index[position].offset;
+    Result.size = index[position].size;
+    Result.negative = index[position].flags & FLAG_NEGATIVE;
+    return Result;
+}
+
+void NumberStore::forEachChunk(size_t chunkSize, const std::function<void(size_t begin, size_t end)> &task) const
+{
+    chunkSize = std::max<size_t>(chunkSize, 1);
+    Utils::parallelFor((size() + chunkSize - 1) / chunkSize, [&](size_t chunk)
+    {
+        task(chunk * chunkSize, std::min(size(), (chunk + 1) * chunkSize));
+    });
+}
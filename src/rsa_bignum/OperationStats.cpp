@@ -0,0 +1,72 @@
+#include "rsa_bignum/OperationStats.h"
+#include <atomic>
+#include <iomanip>
+#include <type_traits>
+
+namespace
+{
+    std::atomic<unsigned long long> Totals[STAT_COUNTER_COUNT];
+
+    struct ThreadCounters
+    {
+        unsigned long long values[STAT_COUNTER_COUNT];
+        bool registered;
+        bool exited;
+    };
+
+    static_assert(std::is_trivially_destructible<ThreadCounters>::value, "counters must stay usable during thread teardown");
+
+    thread_local ThreadCounters Local;
+
+    struct ThreadExitHook
+    {
+        ~ThreadExitHook()
+        {
+            for (int counter = 0; counter < STAT_COUNTER_COUNT; ++counter)
+            {
+                Totals[counter].fetch_add(Local.values[counter], std::memory_order_relaxed);
+                Local.values[counter] = 0;
+            }
+            Local.exited = true;
+        }
+    };
+}
+
+void OperationStats::record(StatCounter counter, unsigned long long amount)
+{
+    if (Local.exited)
+    {
+        Totals[counter].fetch_add(amount, std::memory_order_relaxed);
+        return;
+    }
+    if (!Local.registered)
+    {
+        Local.registered = true;
+        static thread_local ThreadExitHook Hook;
+        (void)Hook;
+    }
+    Local.values[counter] += amount;
+}
+
+unsigned long long OperationStats::total(StatCounter counter)
+{
+    return Totals[counter].load(std::memory_order_relaxed) + Local.values[counter];
+}
+
+const char *OperationStats::name(StatCounter counter)
+{
+    static const char *NAMES[STAT_COUNTER_COUNT] = {
+        "add", "subtract", "multiply", "divide", "modular_exponentiation", "inverse", "greatest_common_divisor",
+        "multiply_schoolbook", "multiply_karatsuba", "multiply_toom_cook", "multiply_ntt", "divide_schoolbook", "divide_newton",
+        "montgomery_multiply", "big_integer_add", "big_integer_subtract", "big_integer_multiply", "big_integer_divide", "big_integer_modulo",
+        "large_number_construct", "large_number_copy", "large_number_move", "big_integer_construct", "big_integer_copy",
+        "digits_copied", "allocations", "allocated_bytes"};
+    return NAMES[counter];
+}
+
+void OperationStats::print(std::ostream &output)
+{
+    output << "operation statistics:" << std::endl;
+    for (int counter = 0; counter < STAT_COUNTER_COUNT; ++counter)
+        output << "  " << std::left << std::setw(26) << name(StatCounter(counter)) << std::right << std::setw(20) << total(StatCounter(counter)) << std::endl;
+}
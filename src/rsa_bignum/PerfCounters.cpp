@@ -0,0 +1,105 @@
+#include "rsa_bignum/PerfCounters.h"
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+PerfCounters::PerfCounters()
+{
+    for (int &descriptor : descriptors)
+        descriptor = -1;
+}
+
+PerfCounters::~PerfCounters()
+{
+#if defined(__linux__)
+    for (int descriptor : descriptors)
+        if (descriptor >= 0)
+            close(descriptor);
+#endif
+}
+
+bool PerfCounters::open()
+{
+#if defined(__linux__)
+    const unsigned long long L1D_READ_MISS = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const struct
+    {
+        unsigned type;
+        unsigned long long config;
+    } EVENTS[PERF_EVENT_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, L1D_READ_MISS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    };
+    if (leader >= 0)
+        return true;
+    for (int event = 0; event < PERF_EVENT_COUNT; ++event)
+    {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = EVENTS[event].type;
+        attributes.config = EVENTS[event].config;
+        attributes.disabled = leader < 0;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        descriptors[event] = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, leader < 0 ? -1 : descriptors[leader], 0);
+        if (descriptors[event] < 0)
+            continue;
+        if (leader < 0)
+            leader = event;
+        members[memberCount++] = event;
+    }
+#endif
+    return isOpen();
+}
+
+bool PerfCounters::isOpen() const
+{
+    return leader >= 0;
+}
+
+void PerfCounters::start()
+{
+#if defined(__linux__)
+    if (leader < 0)
+        return;
+    ioctl(descriptors[leader], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(descriptors[leader], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+PerfReading PerfCounters::stop()
+{
+    PerfReading Result;
+#if defined(__linux__)
+    if (leader < 0)
+        return Result;
+    ioctl(descriptors[leader], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    // Group read layout: member count, time enabled, time running, then one value per member in open order.
+    unsigned long long values[3 + PERF_EVENT_COUNT];
+    ssize_t expected = sizeof(unsigned long long) * (3 + memberCount);
+    if (read(descriptors[leader], values, sizeof(values)) != expected || values[0] != (unsigned long long)memberCount || values[2] == 0)
+        return Result;
+    for (int member = 0; member < memberCount; ++member)
+    {
+        Result.available[members[member]] = true;
+        Result.values[members[member]] = values[1] == values[2] ? double(values[3 + member]) : double(values[3 + member]) * values[1] / values[2];
+    }
+#endif
+    return Result;
+}
+
+const char *PerfCounters::name(PerfEvent event)
+{
+    static const char *NAMES[PERF_EVENT_COUNT] = {"cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses", "page_faults"};
+    return NAMES[event];
+}
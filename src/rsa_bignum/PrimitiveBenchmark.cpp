@@ -0,0 +1,292 @@
+#include "rsa_bignum/PrimitiveBenchmark.h"
+#include "rsa_bignum/ArithmeticBackend.h"
+#include "rsa_bignum/BigInteger.h"
+#include "rsa_bignum/ConversionOperations.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include "rsa_bignum/LargeNumberChecking.h"
+#include "rsa_bignum/LargeNumberSpecialOperations.h"
+#include "rsa_bignum/LimbKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <map>
+
+namespace
+{
+    // One prime per default size, from tools/generate_corpus.py's random_prime seeded with SEED + bits.
+    const std::map<size_t, const char *> KNOWN_PRIMES = {
+        {256,
+         "E120103A31B5E67E73F8AC655B26D2B21BDF8E15710D5AE608F70410D1ED065F"},
+        {512,
+         "DF5945773533257B51A1A34D6ACC0B778EAE6EF7DE4C6E6F9EF86B7EBE7A1B8DFBF3A9D2FFA22B8254629C2230E571E41529C6D1EC974C7D7264B9813709528F"},
+        {1024,
+         "E9229D6B79DB38B5759D7FC5E6986B03874A449E906DB0EBE24268ACF062C227DB294B427D335B46CBD3C43AB92653447889B802A071DD6E81E160D315B41D80"
+         "8C3FB01CCF7C173D7A837A420118A28E6B86C80F8D2704D8678CA9EB898E700A76DB2E3DC389A574F3918A3F347D8A1095AF1829EDEBFC2B6813C2D25D47DB15"},
+        {2048,
+         "B2D060290A4E77E85D90B48099A642E3510943548407F564235C8143474ACF837C6C7CC266B9DE47667F18FAA45384880CDFE39EDA238171558EE44BF28DF959"
+         "D63D48F33E3A7A287CB666D92378FACC609D030835872012E58F76B80FB4916E5DFB182DEA8BAE38FD4700157B02AE77ABA13F2FA90DA1D8DFA07D4EAC3AE955"
+         "A26139709CA931244627B49B64DCC8D3F29CD4035BC2EB2F58E9D384E5CABF435B4F45E866577A6F0CED5C120B7454ED81D0B56D6465CA6E95508D15938D7629"
+         "3DB1982226A21E3CCBFA7E0527015F0A87DDEE11B6047484D9B8259EE4FD17F2E9A2B757B39200AE482467DC3BD257A3D66A8513F7312BEB1BAD47C3B016970D"},
+        {4096,
+         "C0F6037A44B4D2BD8942D15C20009830EC97E55E50BD163ED7F24344888333B95871AE547D4E3BB5D714BB0D72486D0105525BFE0F2E0DC1F229E8A16BFF108F"
+         "756D46B6F1764C1061477B241C615CD7EE89D8F146A65F71E2B1EE313420FA19D6A760B48610345BF0AAC725648D8B73CC68373ACF28F41276526B4C0CE6D9C5"
+         "D4890356D09EEA22D939B1A5C7DA0ACA3C1583DD471564720CCFF234BBCA1F1902100A97F5BAE1B2D2A4E8B4E78E120B0BD78EA682F0EC707829F5D515FAD654"
+         "3743419D8E139218E2DD1B35D3010CAB57015A768728519A7E535763E40E1DE16E2953378AFB27C10355A130E7A75C746D8FBDCBEFDF6D39AF6FD9ED481271CC"
+         "C2D498C0DCA9E5EAD699EA0B7D990890FCE2379354567198FCE327C56D69BA53A004595861E042AB40489F1C3027B9295E27D96ACF1D210158030D9DBDB0E205"
+         "837AA56BEA8FF65E045F06F1871C539D4B8388E5A64985B00BD48D6A110DDBB17D2815187435201C346004E6F559080CCCB337BA4FA66428A0AAB9A6ECA4D6BE"
+         "3ED4C6D08315A0FDD9F09EA4395BCC36FA194E3C17F9067C101986721924756172E97BB629D65D0323C7802B27BF633C03F784B9A5B069318E967BE0114EF54F"
+         "0E5AC19F47F571BD43D4D8F165F5317EBEF5E2C00358AC225B016186EFC745F9F5D6724750749A954E2589B69536845FA62A1C8CD67D9752F830A859FEDA5B7D"}
+    };
+}
+
+std::string PrimitiveBenchmark::randomHex(std::mt19937_64 &generator, size_t bits, bool odd)
+{
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    std::uniform_int_distribution<int> nibble(0, 15);
+    std::string hex((bits + 3) / 4, '0');
+    for (char &c : hex)
+        c = HEX_DIGITS[nibble(generator)];
+    int topBits = bits % 4 == 0 ? 4 : bits % 4;
+    hex[0] = HEX_DIGITS[(nibble(generator) & ((1 << (topBits - 1)) - 1)) | (1 << (topBits - 1))];
+    if (odd)
+        hex.back() = HEX_DIGITS[(nibble(generator) & 14) | 1];
+    return hex;
+}
+
+std::string PrimitiveBenchmark::primeHex(std::mt19937_64 &generator, size_t bits)
+{
+    auto known = KNOWN_PRIMES.find(bits);
+    if (known != KNOWN_PRIMES.end())
+        return known->second;
+    // Other sizes search upward from a random odd start; multiples of primes below 100 are skipped
+    // before the Fermat test, which is what makes large sizes slow to set up.
+    const int SMALL_PRIMES[] = {3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97};
+    LargeNumber Candidate = ConversionOperations::convertHexToLargeNumber(randomHex(generator, bits, true)), Divisor, Two;
+    Two.digits[0] = 2;
+    std::vector<int> residues;
+    for (int prime : SMALL_PRIMES)
+    {
+        Divisor.digits[0] = prime;
+        residues.push_back(LargeNumberArithmetic::divideByLargeNumber(Candidate, Divisor).remainder.digits[0]);
+    }
+    for (size_t offset = 0;; offset += 2, Candidate = LargeNumberArithmetic::addLargeNumbers(Candidate, Two))
+    {
+        bool sieved = true;
+        for (size_t i = 0; i < residues.size() && sieved; ++i)
+            sieved = (residues[i] + offset) % SMALL_PRIMES[i] != 0;
+        if (sieved && LargeNumberChecking::isPrimeNumber(Candidate))
+            return ConversionOperations::convertDecimalToHexBigEndian(Candidate);
+    }
+}
+
+PrimitiveResult PrimitiveBenchmark::measure(const std::string &primitive, size_t bits, const PrimitiveOptions &options, const std::function<void(size_t)> &operation, PerfCounters *counters)
+{
+    PrimitiveResult Result;
+    Result.primitive = primitive;
+    Result.bits = bits;
+    Result.iterations = 1;
+    auto timeIterations = [&](size_t iterations)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            operation(i);
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    };
+    for (double elapsed = timeIterations(1); elapsed < options.minimumTimeMs * 1e6; elapsed = timeIterations(Result.iterations))
+        Result.iterations = elapsed <= 0 ? Result.iterations * 2 : std::max(Result.iterations * 2, (size_t)std::ceil(Result.iterations * options.minimumTimeMs * 1.2e6 / elapsed));
+    for (size_t repetition = 0; repetition < std::max<size_t>(1, options.repetitions); ++repetition)
+    {
+        if (counters)
+            counters->start();
+        Result.samples.push_back(timeIterations(Result.iterations) / Result.iterations);
+        if (!counters)
+            continue;
+        PerfReading Reading = counters->stop();
+        for (int event = 0; event < PERF_EVENT_COUNT; ++event)
+        {
+            Result.counters.available[event] = Reading.available[event];
+            Result.counters.values[event] += Reading.values[event];
+        }
+    }
+    for (double &value : Result.counters.values)
+        value /= double(Result.iterations) * Result.samples.size();
+    std::vector<double> sorted = Result.samples;
+    std::sort(sorted.begin(), sorted.end());
+    size_t count = sorted.size();
+    Result.medianNs = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+    Result.minimumNs = sorted.front();
+    Result.meanNs = 0;
+    for (double sample : sorted)
+        Result.meanNs += sample / count;
+    Result.deviationNs = 0;
+    for (double sample : sorted)
+        Result.deviationNs += (sample - Result.meanNs) * (sample - Result.meanNs);
+    Result.deviationNs = count > 1 ? std::sqrt(Result.deviationNs / (count - 1)) : 0;
+    Result.operationsPerSecond = Result.medianNs > 0 ? 1e9 / Result.medianNs : 0;
+    return Result;
+}
+
+std::vector<PrimitiveResult> PrimitiveBenchmark::run(const PrimitiveOptions &options, std::ostream &log)
+{
+    const size_t POOL_SIZE = 8;
+    std::vector<PrimitiveResult> Results;
+    volatile size_t sink = 0;
+    PerfCounters Counters;
+    if (options.counters && !Counters.open())
+        log << "perf_event_open unavailable, counters disabled" << std::endl;
+    PerfCounters *ActiveCounters = options.counters && Counters.isOpen() ? &Counters : nullptr;
+    const char *DERIVED[] = {"ipc", "branch_mpki", "l1d_mpki", "llc_mpki", "page_faults_per_op"};
+    log << std::left << std::setw(36) << "primitive" << std::right << std::setw(6) << "bits" << std::setw(16) << "ns/op" << std::setw(14) << "ops/sec" << std::setw(10) << "stddev%";
+    if (ActiveCounters)
+        for (const char *metric : DERIVED)
+            log << std::setw(20) << metric;
+    log << std::endl;
+    for (size_t bits : options.bits)
+    {
+        std::mt19937_64 generator(SEED + bits);
+        std::vector<std::string> firstHex, secondHex, wideHex, oddHex;
+        std::vector<LargeNumber> first, second, wide, odd;
+        std::vector<BigInteger> firstBig, secondBig, wideBig;
+        for (size_t i = 0; i < POOL_SIZE; ++i)
+        {
+            firstHex.push_back(randomHex(generator, bits, false));
+            secondHex.push_back(randomHex(generator, bits, false));
+            wideHex.push_back(randomHex(generator, bits * 2, false));
+            oddHex.push_back(randomHex(generator, bits, true));
+            first.push_back(ConversionOperations::convertHexToLargeNumber(firstHex.back()));
+            second.push_back(ConversionOperations::convertHexToLargeNumber(secondHex.back()));
+            wide.push_back(ConversionOperations::convertHexToLargeNumber(wideHex.back()));
+            odd.push_back(ConversionOperations::convertHexToLargeNumber(oddHex.back()));
+            firstBig.push_back(ConversionOperations::convertHexBigEndianToDecimal(firstHex.back()));
+            secondBig.push_back(ConversionOperations::convertHexBigEndianToDecimal(secondHex.back()));
+            wideBig.push_back(ConversionOperations::convertHexBigEndianToDecimal(wideHex.back()));
+        }
+        // isPrimeNumber is timed separately on a known prime and on odd composites built as a product of two halves.
+        LargeNumber prime = ConversionOperations::convertHexToLargeNumber(primeHex(generator, bits));
+        std::vector<LargeNumber> composite;
+        for (size_t i = 0; i < POOL_SIZE; ++i)
+            composite.push_back(LargeNumberArithmetic::multiplyLargeNumbers(ConversionOperations::convertHexToLargeNumber(randomHex(generator, bits / 2, true)),
+                                                                            ConversionOperations::convertHexToLargeNumber(randomHex(generator, bits - bits / 2, true))));
+        std::vector<std::pair<std::string, std::function<void(size_t)>>> primitives = {
+            {"addLargeNumbers", [&](size_t i) { sink = sink + LargeNumberArithmetic::addLargeNumbers(first[i % POOL_SIZE], second[i % POOL_SIZE]).digits.size(); }},
+            {"subtractLargeNumbers", [&](size_t i) { sink = sink + LargeNumberArithmetic::subtractLargeNumbers(first[i % POOL_SIZE], second[i % POOL_SIZE]).digits.size(); }},
+            {"multiplyLargeNumbers", [&](size_t i) { sink = sink + LargeNumberArithmetic::multiplyLargeNumbers(first[i % POOL_SIZE], second[i % POOL_SIZE]).digits.size(); }},
+            {"divideByLargeNumber", [&](size_t i) { sink = sink + LargeNumberArithmetic::divideByLargeNumber(wide[i % POOL_SIZE], first[i % POOL_SIZE]).quotient.digits.size(); }},
+            {"modularExponentiation", [&](size_t i) { sink = sink + LargeNumberSpecialOperations::modularExponentiation(first[i % POOL_SIZE], second[i % POOL_SIZE], odd[i % POOL_SIZE]).digits.size(); }},
+            {"inverse", [&](size_t i) { sink = sink + LargeNumberSpecialOperations::inverse(first[i % POOL_SIZE], odd[i % POOL_SIZE]).digits.size(); }},
+            {"isPrimeNumber/prime", [&](size_t) { sink = sink + LargeNumberChecking::isPrimeNumber(prime); }},
+            {"isPrimeNumber/composite", [&](size_t i) { sink = sink + LargeNumberChecking::isPrimeNumber(composite[i % POOL_SIZE]); }},
+            {"convertHexToLargeNumber", [&](size_t i) { sink = sink + ConversionOperations::convertHexToLargeNumber(firstHex[i % POOL_SIZE]).digits.size(); }},
+            {"convertHexBigEndianToDecimal", [&](size_t i) { sink = sink + ConversionOperations::convertHexBigEndianToDecimal(firstHex[i % POOL_SIZE]).toString().size(); }},
+            {"convertDecimalToHexBigEndian", [&](size_t i) { sink = sink + ConversionOperations::convertDecimalToHexBigEndian(first[i % POOL_SIZE]).size(); }},
+            {"BigInteger::operator+", [&](size_t i) { sink = sink + (firstBig[i % POOL_SIZE] + secondBig[i % POOL_SIZE]).toString().size(); }},
+            {"BigInteger::operator*", [&](size_t i) { sink = sink + (firstBig[i % POOL_SIZE] * secondBig[i % POOL_SIZE]).toString().size(); }},
+            {"BigInteger::operator/", [&](size_t i) { sink = sink + (wideBig[i % POOL_SIZE] / firstBig[i % POOL_SIZE]).toString().size(); }},
+            {"BigInteger::operator%", [&](size_t i) { sink = sink + (wideBig[i % POOL_SIZE] % firstBig[i % POOL_SIZE]).toString().size(); }},
+        };
+        for (const auto &primitive : primitives)
+        {
+            if (!options.filter.empty() && primitive.first.find(options.filter) == std::string::npos)
+                continue;
+            Results.push_back(measure(primitive.first, bits, options, primitive.second, ActiveCounters));
+            const PrimitiveResult &Last = Results.back();
+            log << std::left << std::setw(36) << Last.primitive << std::right << std::setw(6) << Last.bits
+                << std::fixed << std::setprecision(1) << std::setw(16) << Last.medianNs << std::setw(14) << Last.operationsPerSecond
+                << std::setprecision(2) << std::setw(10) << (Last.meanNs > 0 ? 100 * Last.deviationNs / Last.meanNs : 0);
+            double value = 0;
+            if (ActiveCounters)
+                for (const char *metric : DERIVED)
+                {
+                    if (derivedCounter(Last.counters, metric, value))
+                        log << std::setprecision(3) << std::setw(20) << value;
+                    else
+                        log << std::setw(20) << "-";
+                }
+            log << std::endl;
+        }
+    }
+    return Results;
+}
+
+void PrimitiveBenchmark::writeJson(const std::vector<PrimitiveResult> &results, const PrimitiveOptions &options, std::ostream &output)
+{
+    const ArithmeticThresholds &Thresholds = LargeNumberArithmetic::thresholds();
+    output << std::setprecision(17);
+    output << "{\n  \"context\": {\n";
+    output << "    \"backend\": \"" << escapeJson(ArithmeticBackend::name()) << "\",\n";
+    output << "    \"limb_kernel\": \"" << escapeJson(LimbKernels::activeKernels().name) << "\",\n";
+    output << "    \"seed\": " << SEED << ",\n";
+    output << "    \"repetitions\": " << options.repetitions << ",\n";
+    output << "    \"minimum_time_ms\": " << options.minimumTimeMs << ",\n";
+    output << "    \"thresholds\": {\"karatsuba\": " << Thresholds.karatsuba << ", \"toom_cook\": " << Thresholds.toomCook
+           << ", \"ntt\": " << Thresholds.ntt << ", \"newton_division\": " << Thresholds.newtonDivision << "}\n";
+    output << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const PrimitiveResult &Entry = results[i];
+        output << (i ? ",\n" : "\n") << "    {\"name\": \"" << escapeJson(Entry.primitive) << '/' << Entry.bits << "\", "
+               << "\"primitive\": \"" << escapeJson(Entry.primitive) << "\", \"bits\": " << Entry.bits << ", "
+               << "\"iterations\": " << Entry.iterations << ", \"repetitions\": " << Entry.samples.size() << ", "
+               << "\"mean_ns\": " << Entry.meanNs << ", \"median_ns\": " << Entry.medianNs << ", "
+               << "\"min_ns\": " << Entry.minimumNs << ", \"stddev_ns\": " << Entry.deviationNs << ", "
+               << "\"ops_per_sec\": " << Entry.operationsPerSecond << ", \"samples_ns\": [";
+        for (size_t j = 0; j < Entry.samples.size(); ++j)
+            output << (j ? ", " : "") << Entry.samples[j];
+        output << "]";
+        if (options.counters)
+        {
+            output << ", \"counters_per_op\": {";
+            for (int event = 0; event < PERF_EVENT_COUNT; ++event)
+            {
+                output << (event ? ", " : "") << '"' << PerfCounters::name(PerfEvent(event)) << "\": ";
+                if (Entry.counters.available[event])
+                    output << Entry.counters.values[event];
+                else
+                    output << "null";
+            }
+            output << "}";
+            double value = 0;
+            for (const char *metric : {"ipc", "branch_mpki", "l1d_mpki", "llc_mpki"})
+            {
+                output << ", \"" << metric << "\": ";
+                if (derivedCounter(Entry.counters, metric, value))
+                    output << value;
+                else
+                    output << "null";
+            }
+        }
+        output << "}";
+    }
+    output << "\n  ]\n}\n";
+}
+
+bool PrimitiveBenchmark::derivedCounter(const PerfReading &reading, const std::string &metric, double &value)
+{
+    const bool HAS_INSTRUCTIONS = reading.available[PERF_INSTRUCTIONS] && reading.values[PERF_INSTRUCTIONS] > 0;
+    if (metric == "ipc" && HAS_INSTRUCTIONS && reading.available[PERF_CYCLES] && reading.values[PERF_CYCLES] > 0)
+        value = reading.values[PERF_INSTRUCTIONS] / reading.values[PERF_CYCLES];
+    else if (metric == "branch_mpki" && HAS_INSTRUCTIONS && reading.available[PERF_BRANCH_MISSES])
+        value = 1000 * reading.values[PERF_BRANCH_MISSES] / reading.values[PERF_INSTRUCTIONS];
+    else if (metric == "l1d_mpki" && HAS_INSTRUCTIONS && reading.available[PERF_L1D_MISSES])
+        value = 1000 * reading.values[PERF_L1D_MISSES] / reading.values[PERF_INSTRUCTIONS];
+    else if (metric == "llc_mpki" && HAS_INSTRUCTIONS && reading.available[PERF_LLC_MISSES])
+        value = 1000 * reading.values[PERF_LLC_MISSES] / reading.values[PERF_INSTRUCTIONS];
+    else if (metric == "page_faults_per_op" && reading.available[PERF_PAGE_FAULTS])
+        value = reading.values[PERF_PAGE_FAULTS];
+    else
+        return false;
+    return true;
+}
+
+std::string PrimitiveBenchmark::escapeJson(const std::string &value)
+{
+    std::string Result;
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+            Result += '\\';
+        Result += c;
+    }
+    return Result;
+}
@@ -0,0 +1,252 @@
+#include "rsa_bignum/ProcessPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#if defined(__unix__)
+#include <cerrno>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    enum JobState
+    {
+        JOB_PENDING,
+        JOB_RUNNING,
+        JOB_DONE,
+        JOB_FAILED
+    };
+
+    struct SharedJob
+    {
+        std::atomic<int> state;
+        std::atomic<int> owner;
+        long long start;
+        double seconds;
+        char error[104];
+    };
+
+    struct SharedQueue
+    {
+        alignas(64) std::atomic<size_t> head;
+        size_t count;
+    };
+
+    static_assert(std::atomic<size_t>::is_always_lock_free && std::atomic<int>::is_always_lock_free, "the shared job queue needs address-free atomics");
+
+    long long monotonicNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void copyError(SharedJob &slot, const char *message)
+    {
+        std::strncpy(slot.error, message, sizeof(slot.error) - 1);
+        slot.error[sizeof(slot.error) - 1] = '\0';
+    }
+
+    int runJob(const std::function<void(size_t)> &job, size_t index, SharedJob &slot)
+    {
+        int Result = JOB_DONE;
+        slot.start = monotonicNanoseconds();
+        try
+        {
+            job(index);
+        }
+        catch (const char *message)
+        {
+            copyError(slot, message);
+            Result = JOB_FAILED;
+        }
+        catch (const std::exception &exception)
+        {
+            copyError(slot, exception.what());
+            Result = JOB_FAILED;
+        }
+        catch (...)
+        {
+            copyError(slot, "unknown exception");
+            Result = JOB_FAILED;
+        }
+        slot.seconds = (monotonicNanoseconds() - slot.start) * 1e-9;
+        return Result;
+    }
+
+    std::vector<int> parseCpuList(const std::string &list)
+    {
+        std::vector<int> Result;
+        std::stringstream ranges(list);
+        std::string range;
+        while (std::getline(ranges, range, ','))
+        {
+            size_t dash = range.find('-');
+            if (range.find_first_of("0123456789") == std::string::npos)
+                continue;
+            int first = std::stoi(range), last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu)
+                Result.push_back(cpu);
+        }
+        return Result;
+    }
+
+#if defined(__unix__)
+    [[noreturn]] void workerLoop(SharedQueue &queue, SharedJob *slots, const std::function<void(size_t)> &job, const std::vector<int> &cpus)
+    {
+        if (!cpus.empty())
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpus)
+                if (cpu < CPU_SETSIZE)
+                    CPU_SET(cpu, &set);
+            sched_setaffinity(0, sizeof(set), &set);
+        }
+        while (true)
+        {
+            size_t index = queue.head.fetch_add(1, std::memory_order_acq_rel);
+            if (index >= queue.count)
+                _exit(0);
+            SharedJob &slot = slots[index];
+            slot.owner.store(getpid(), std::memory_order_relaxed);
+            slot.state.store(JOB_RUNNING, std::memory_order_release);
+            slot.state.store(runJob(job, index, slot), std::memory_order_release);
+        }
+    }
+
+    std::string describeExit(int status)
+    {
+        if (WIFSIGNALED(status))
+            return std::string("worker killed by signal ") + std::to_string(WTERMSIG(status)) + " (" + strsignal(WTERMSIG(status)) + ")";
+        return "worker exited with status " + std::to_string(WEXITSTATUS(status));
+    }
+#endif
+}
+
+std::vector<std::vector<int>> ProcessPool::numaNodes()
+{
+    std::map<int, std::vector<int>> nodes;
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", error))
+    {
+        const std::string name = entry.path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0 || name.find_first_not_of("0123456789", 4) != std::string::npos)
+            continue;
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        if (std::getline(file, list) && !parseCpuList(list).empty())
+            nodes[std::stoi(name.substr(4))] = parseCpuList(list);
+    }
+    std::vector<std::vector<int>> Result;
+    for (auto &node : nodes)
+        Result.push_back(node.second);
+    return Result;
+}
+
+std::vector<ProcessJobResult> ProcessPool::run(size_t jobCount, const std::function<void(size_t)> &job, size_t processes, bool pinNuma)
+{
+    std::vector<ProcessJobResult> Result(jobCount);
+    if (!jobCount)
+        return Result;
+#if defined(__unix__)
+    const size_t bytes = sizeof(SharedQueue) + jobCount * sizeof(SharedJob);
+    void *memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        throw("ProcessPool Error: cannot map the shared job queue");
+    SharedQueue *queue = new (memory) SharedQueue();
+    queue->head.store(0, std::memory_order_relaxed);
+    queue->count = jobCount;
+    SharedJob *slots = reinterpret_cast<SharedJob *>(static_cast<char *>(memory) + sizeof(SharedQueue));
+    for (size_t i = 0; i < jobCount; ++i)
+    {
+        new (&slots[i]) SharedJob();
+        slots[i].state.store(JOB_PENDING, std::memory_order_relaxed);
+        slots[i].owner.store(0, std::memory_order_relaxed);
+    }
+
+    const std::vector<std::vector<int>> nodes = pinNuma ? numaNodes() : std::vector<std::vector<int>>();
+    processes = std::max<size_t>(1, std::min(processes, jobCount));
+    std::map<pid_t, size_t> workers;
+    auto spawn = [&](size_t worker)
+    {
+        std::cout.flush();
+        std::cerr.flush();
+        pid_t pid = fork();
+        if (pid == 0)
+            workerLoop(*queue, slots, job, nodes.empty() ? std::vector<int>() : nodes[worker % nodes.size()]);
+        if (pid > 0)
+            workers[pid] = worker;
+    };
+    for (size_t worker = 0; worker < processes; ++worker)
+        spawn(worker);
+    if (workers.empty())
+    {
+        munmap(memory, bytes);
+        throw("ProcessPool Error: cannot fork worker processes");
+    }
+
+    while (!workers.empty())
+    {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        auto found = workers.find(pid);
+        if (found == workers.end())
+            continue;
+        size_t worker = found->second;
+        workers.erase(found);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+            continue;
+        const std::string reason = describeExit(status);
+        for (size_t i = 0; i < jobCount; ++i)
+            if (slots[i].state.load(std::memory_order_acquire) == JOB_RUNNING && slots[i].owner.load(std::memory_order_relaxed) == pid)
+            {
+                copyError(slots[i], reason.c_str());
+                slots[i].seconds = (monotonicNanoseconds() - slots[i].start) * 1e-9;
+                slots[i].state.store(JOB_FAILED, std::memory_order_release);
+                std::cerr << "Worker " << pid << " failed on job " << i << ": " << reason << std::endl;
+            }
+        if (queue->head.load(std::memory_order_acquire) < jobCount)
+            spawn(worker);
+    }
+
+    for (size_t i = 0; i < jobCount; ++i)
+    {
+        int state = slots[i].state.load(std::memory_order_acquire);
+        Result[i].succeeded = state == JOB_DONE;
+        Result[i].seconds = slots[i].seconds;
+        if (state == JOB_FAILED)
+            Result[i].error = slots[i].error;
+        else if (state != JOB_DONE)
+            Result[i].error = "worker exited before finishing the job";
+    }
+    munmap(memory, bytes);
+#else
+    (void)processes;
+    (void)pinNuma;
+    for (size_t i = 0; i < jobCount; ++i)
+    {
+        SharedJob slot;
+        Result[i].succeeded = runJob(job, i, slot) == JOB_DONE;
+        Result[i].seconds = slot.seconds;
+        if (!Result[i].succeeded)
+            Result[i].error = slot.error;
+    }
+#endif
+    return Result;
+}
@@ -0,0 +1,140 @@
+#include "rsa_bignum/ServerProtocol.h"
+#include "rsa_bignum/BinaryFormat.h"
+#include <cerrno>
+#include <cstring>
+#if defined(__unix__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#if defined(__unix__)
+    bool socketAddress(const std::string &path, sockaddr_un &address)
+    {
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path))
+            return false;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    bool readExactly(int descriptor, char *buffer, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t count = read(descriptor, buffer, size);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                return false;
+            buffer += count;
+            size -= count;
+        }
+        return true;
+    }
+
+    bool writeExactly(int descriptor, const char *buffer, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t count = send(descriptor, buffer, size, MSG_NOSIGNAL);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                return false;
+            buffer += count;
+            size -= count;
+        }
+        return true;
+    }
+#endif
+}
+
+int ServerProtocol::listenOn(const std::string &path)
+{
+#if defined(__unix__)
+    sockaddr_un address;
+    if (!socketAddress(path, address))
+        return -1;
+    int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor < 0)
+        return -1;
+    unlink(path.c_str());
+    if (bind(descriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || listen(descriptor, 64) < 0)
+    {
+        close(descriptor);
+        return -1;
+    }
+    return descriptor;
+#else
+    return -1;
+#endif
+}
+
+int ServerProtocol::connectTo(const std::string &path)
+{
+#if defined(__unix__)
+    sockaddr_un address;
+    if (!socketAddress(path, address))
+        return -1;
+    int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor < 0)
+        return -1;
+    if (connect(descriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+    {
+        close(descriptor);
+        return -1;
+    }
+    return descriptor;
+#else
+    return -1;
+#endif
+}
+
+bool ServerProtocol::readFrame(int descriptor, std::string &payload)
+{
+#if defined(__unix__)
+    unsigned char prefix[4];
+    if (!readExactly(descriptor, reinterpret_cast<char *>(prefix), sizeof(prefix)))
+        return false;
+    size_t length = size_t(prefix[0]) << 24 | size_t(prefix[1]) << 16 | size_t(prefix[2]) << 8 | prefix[3];
+    if (length > MAX_FRAME_BYTES)
+        return false;
+    payload.resize(length);
+    return readExactly(descriptor, payload.data(), length);
+#else
+    return false;
+#endif
+}
+
+bool ServerProtocol::writeFrame(int descriptor, std::string_view payload)
+{
+#if defined(__unix__)
+    if (payload.size() > MAX_FRAME_BYTES)
+        return false;
+    std::string frame;
+    frame.reserve(4 + payload.size());
+    for (int shift = 24; shift >= 0; shift -= 8)
+        frame.push_back(char(payload.size() >> shift));
+    frame.append(payload);
+    return writeExactly(descriptor, frame.data(), frame.size());
+#else
+    return false;
+#endif
+}
+
+bool ServerProtocol::parseRecords(std::string_view payload, size_t offset, std::vector<ProtocolRecord> &records)
+{
+    records.clear();
+    ProtocolRecord record;
+    while (offset < payload.size())
+    {
+        if (!BinaryFormat::readRecord(payload, offset, record.magnitude, record.negative))
+            return false;
+        records.push_back(record);
+    }
+    return true;
+}
@@ -0,0 +1,154 @@
+#include "rsa_bignum/SmallDigitVector.h"
+#include <algorithm>
+
+SmallDigitVector::SmallDigitVector(size_t count, int value)
+{
+    resize(count, value);
+}
+
+SmallDigitVector::SmallDigitVector(const std::vector<int> &values)
+{
+    resize(values.size());
+    std::copy(values.begin(), values.end(), begin());
+}
+
+SmallDigitVector::SmallDigitVector(const SmallDigitVector &other)
+{
+    *this = other;
+}
+
+SmallDigitVector::SmallDigitVector(SmallDigitVector &&other) noexcept
+{
+    *this = std::move(other);
+}
+
+SmallDigitVector &SmallDigitVector::operator=(const SmallDigitVector &other)
+{
+    if (this == &other)
+        return *this;
+    if (other.length > INLINE_CAPACITY)
+        heapDigits = other.heapDigits;
+    else
+    {
+        heapDigits.clear();
+        std::copy(other.inlineDigits, other.inlineDigits + other.length, inlineDigits);
+    }
+    length = other.length;
+    return *this;
+}
+
+SmallDigitVector &SmallDigitVector::operator=(SmallDigitVector &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+    if (other.length > INLINE_CAPACITY)
+        heapDigits = std::move(other.heapDigits);
+    else
+    {
+        heapDigits.clear();
+        std::copy(other.inlineDigits, other.inlineDigits + other.length, inlineDigits);
+    }
+    length = other.length;
+    other.length = 0;
+    other.heapDigits.clear();
+    return *this;
+}
+
+size_t SmallDigitVector::size() const
+{
+    return length;
+}
+
+bool SmallDigitVector::empty() const
+{
+    return length == 0;
+}
+
+int *SmallDigitVector::data()
+{
+    return length > INLINE_CAPACITY ? heapDigits.data() : inlineDigits;
+}
+
+const int *SmallDigitVector::data() const
+{
+    return length > INLINE_CAPACITY ? heapDigits.data() : inlineDigits;
+}
+
+int *SmallDigitVector::begin()
+{
+    return data();
+}
+
+int *SmallDigitVector::end()
+{
+    return data() + length;
+}
+
+const int *SmallDigitVector::begin() const
+{
+    return data();
+}
+
+const int *SmallDigitVector::end() const
+{
+    return data() + length;
+}
+
+int &SmallDigitVector::operator[](size_t index)
+{
+    return data()[index];
+}
+
+const int &SmallDigitVector::operator[](size_t index) const
+{
+    return data()[index];
+}
+
+int &SmallDigitVector::back()
+{
+    return data()[length - 1];
+}
+
+const int &SmallDigitVector::back() const
+{
+    return data()[length - 1];
+}
+
+void SmallDigitVector::resize(size_t count, int value)
+{
+    if (count <= INLINE_CAPACITY)
+    {
+        if (length > INLINE_CAPACITY)
+        {
+            std::copy(heapDigits.begin(), heapDigits.begin() + count, inlineDigits);
+            heapDigits.clear();
+        }
+        else if (count > length)
+            std::fill(inlineDigits + length, inlineDigits + count, value);
+    }
+    else
+    {
+        if (length <= INLINE_CAPACITY)
+            heapDigits.assign(inlineDigits, inlineDigits + length);
+        heapDigits.resize(count, value);
+    }
+    length = count;
+}
+
+void SmallDigitVector::push_back(int value)
+{
+    if (length < INLINE_CAPACITY)
+        inlineDigits[length++] = value;
+    else
+        resize(length + 1, value);
+}
+
+void SmallDigitVector::pop_back()
+{
+    resize(length - 1);
+}
+
+std::vector<int> SmallDigitVector::toVector() const
+{
+    return std::vector<int>(begin(), end());
+}
@@ -0,0 +1,52 @@
+#include "rsa_bignum/ThresholdConfig.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+std::string ThresholdConfig::configPath()
+{
+    const char *path = std::getenv("RSA_THRESHOLDS");
+    return path != nullptr && *path != '\0' ? path : DEFAULT_PATH;
+}
+
+ArithmeticThresholds ThresholdConfig::defaults()
+{
+    return {LargeNumberArithmetic::KARATSUBA_THRESHOLD, LargeNumberArithmetic::TOOM_COOK_THRESHOLD, LargeNumberArithmetic::NTT_THRESHOLD, LargeNumberArithmetic::NEWTON_DIVISION_THRESHOLD};
+}
+
+ArithmeticThresholds ThresholdConfig::load(const std::string &path)
+{
+    ArithmeticThresholds Result = defaults();
+    std::ifstream input(path);
+    std::string line;
+    while (std::getline(input, line))
+    {
+        std::istringstream fields(line);
+        std::string key;
+        unsigned long long value;
+        if (!(fields >> key >> value) || value < MINIMUM_THRESHOLD || value > MAXIMUM_THRESHOLD)
+            continue;
+        if (key == "karatsuba_threshold")
+            Result.karatsuba = value;
+        else if (key == "toom_cook_threshold")
+            Result.toomCook = value;
+        else if (key == "ntt_threshold")
+            Result.ntt = value;
+        else if (key == "newton_division_threshold")
+            Result.newtonDivision = value;
+    }
+    return Result;
+}
+
+bool ThresholdConfig::save(const ArithmeticThresholds &thresholds, const std::string &path)
+{
+    std::ofstream output(path);
+    if (!output.is_open())
+        return false;
+    output << "# Crossover sizes in base-100 digits, written by rsa_bench --tune\n";
+    output << "karatsuba_threshold " << thresholds.karatsuba << '\n';
+    output << "toom_cook_threshold " << thresholds.toomCook << '\n';
+    output << "ntt_threshold " << thresholds.ntt << '\n';
+    output << "newton_division_threshold " << thresholds.newtonDivision << '\n';
+    return output.good();
+}
@@ -0,0 +1,109 @@
+#include "rsa_bignum/Trace.h"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct TraceEvent
+    {
+        const char *name;
+        const char *category;
+        long long index;
+        double start;
+        double duration;
+    };
+
+    struct TraceBuffer
+    {
+        int threadId;
+        std::vector<TraceEvent> events;
+    };
+
+    std::mutex BuffersMutex;
+    std::vector<std::unique_ptr<TraceBuffer>> Buffers;
+    std::chrono::steady_clock::time_point Origin = std::chrono::steady_clock::now();
+    thread_local TraceBuffer *Local = nullptr;
+
+    TraceBuffer &localBuffer()
+    {
+        if (!Local)
+        {
+            std::lock_guard<std::mutex> lock(BuffersMutex);
+            Buffers.push_back(std::unique_ptr<TraceBuffer>(new TraceBuffer{(int)Buffers.size() + 1, {}}));
+            Local = Buffers.back().get();
+        }
+        return *Local;
+    }
+}
+
+void Trace::enable()
+{
+    Origin = std::chrono::steady_clock::now();
+    localBuffer();
+    enabled = true;
+}
+
+double Trace::now()
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - Origin).count();
+}
+
+void Trace::record(const char *name, const char *category, double start, double duration, long long index)
+{
+    localBuffer().events.push_back({name, category, index, start, duration});
+}
+
+bool Trace::write(const std::string &path)
+{
+    std::ofstream output(path);
+    if (!output.is_open())
+        return false;
+    std::lock_guard<std::mutex> lock(BuffersMutex);
+    output.setf(std::ios::fixed);
+    output.precision(3);
+    output << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (const auto &buffer : Buffers)
+    {
+        output << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->threadId
+               << ", \"args\": {\"name\": \"" << (buffer->threadId == 1 ? "main" : "worker " + std::to_string(buffer->threadId - 1)) << "\"}}";
+        first = false;
+        for (const TraceEvent &event : buffer->events)
+        {
+            output << ",\n{\"name\": \"" << escape(event.name) << "\", \"cat\": \"" << escape(event.category) << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->threadId
+                   << ", \"ts\": " << event.start << ", \"dur\": " << event.duration;
+            if (event.index >= 0)
+                output << ", \"args\": {\"index\": " << event.index << "}";
+            output << "}";
+        }
+    }
+    output << "\n]}\n";
+    return output.good();
+}
+
+std::string Trace::escape(const char *value)
+{
+    std::string Result;
+    for (; *value; ++value)
+    {
+        if (*value == '"' || *value == '\\')
+            Result += '\\';
+        Result += *value;
+    }
+    return Result;
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category, long long index) : name(name), category(category), index(index), start(-1)
+{
+    if (Trace::enabled)
+        start = Trace::now();
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (start >= 0)
+        Trace::record(name, category, start, Trace::now() - start, index);
+}
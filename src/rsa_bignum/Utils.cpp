@@ -0,0 +1,83 @@
+#include "rsa_bignum/Utils.h"
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <thread>
+
+namespace
+{
+    thread_local bool InParallelRegion = false;
+}
+
+int Utils::findIndex(const std::vector<std::string> &vec, const std::string &target)
+{
+    auto it = std::find(vec.begin(), vec.end(), target);
+    if (it != vec.end())
+        return std::distance(vec.begin(), it);
+    return -1;
+}
+
+int Utils::findIndex(const std::vector<std::string_view> &vec, std::string_view target)
+{
+    auto it = std::find(vec.begin(), vec.end(), target);
+    if (it != vec.end())
+        return std::distance(vec.begin(), it);
+    return -1;
+}
+
+void Utils::parallelFor(size_t count, const std::function<void(size_t)> &task, size_t workers)
+{
+    workers = std::min<size_t>(count, workers ? workers : std::max(1u, std::thread::hardware_concurrency()));
+    if (workers <= 1 || ParallelRegion::inside())
+    {
+        for (size_t i = 0; i < count; ++i)
+            task(i);
+        return;
+    }
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(workers);
+    for (size_t worker = 0; worker < workers; ++worker)
+        threads.emplace_back([&, worker]()
+        {
+            ParallelRegion Region;
+            try
+            {
+                for (size_t i = worker; i < count; i += workers)
+                    task(i);
+            }
+            catch (...)
+            {
+                errors[worker] = std::current_exception();
+            }
+        });
+    for (auto &thread : threads)
+        thread.join();
+    for (const auto &error : errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+Utils::ParallelRegion::ParallelRegion(bool active) : previous(InParallelRegion)
+{
+    InParallelRegion = previous || active;
+}
+
+Utils::ParallelRegion::~ParallelRegion()
+{
+    InParallelRegion = previous;
+}
+
+bool Utils::ParallelRegion::inside()
+{
+    return InParallelRegion;
+}
+
+bool Utils::parseCount(std::string_view text, size_t &value, size_t maximum)
+{
+    size_t Result = 0;
+    auto parsed = std::from_chars(text.data(), text.data() + text.size(), Result);
+    if (text.empty() || parsed.ec != std::errc() || parsed.ptr != text.data() + text.size() || Result > maximum)
+        return false;
+    value = Result;
+    return true;
+}
@@ -0,0 +1,301 @@
+#include "rsa_bignum/BinaryFormat.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include "rsa_bignum/LargeNumberChecking.h"
+#include "rsa_bignum/LargeNumberSpecialOperations.h"
+#include "rsa_bignum/MultiBufferModexp.h"
+#include "rsa_bignum/ServerProtocol.h"
+#include "rsa_bignum/Utils.h"
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+class ContextCache
+{
+private:
+    typedef std::shared_ptr<const MultiBufferModexp::Context> ContextPointer;
+    size_t capacity;
+    std::mutex mutex;
+    std::list<std::string> order;
+    std::unordered_map<std::string, std::pair<ContextPointer, std::list<std::string>::iterator>> entries;
+
+public:
+    std::atomic<unsigned long long> hits;
+    std::atomic<unsigned long long> misses;
+    explicit ContextCache(size_t capacity);
+    ContextPointer get(std::string_view modulus, std::string_view exponent);
+};
+
+namespace Server
+{
+    std::string handle(std::string_view request, ContextCache &cache);
+    std::string isPrime(const std::vector<ProtocolRecord> &records);
+    std::string deriveKey(const std::vector<ProtocolRecord> &records, bool useCarmichael);
+    std::string encryptBatch(const std::vector<ProtocolRecord> &records, ContextCache &cache);
+    void serve(int connection, ContextCache &cache);
+}
+
+namespace
+{
+    volatile std::sig_atomic_t Stopping = 0;
+
+    void requestStop(int)
+    {
+        Stopping = 1;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: rsa_server <socket_path> [--workers count] [--cache contexts]" << std::endl;
+        return 1;
+    }
+    const std::string path = argv[1];
+    size_t workers = std::max(1u, std::thread::hardware_concurrency()), cacheSize = 64;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        if (option == "--workers" && i + 1 < argc && Utils::parseCount(argv[i + 1], workers) && workers > 0)
+            ++i;
+        else if (option == "--cache" && i + 1 < argc && Utils::parseCount(argv[i + 1], cacheSize) && cacheSize > 0)
+            ++i;
+        else
+        {
+            std::cerr << "Unknown option or invalid value " << option << std::endl;
+            return 1;
+        }
+    }
+    int listener = ServerProtocol::listenOn(path);
+    if (listener < 0)
+    {
+        std::cerr << "Failed to listen on " << path << std::endl;
+        return 1;
+    }
+    struct sigaction action = {};
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigset_t waitMask;
+    pthread_sigmask(SIG_BLOCK, &signals, &waitMask);
+    sigdelset(&waitMask, SIGINT);
+    sigdelset(&waitMask, SIGTERM);
+    fcntl(listener, F_SETFL, fcntl(listener, F_GETFL) | O_NONBLOCK);
+
+    ContextCache cache(cacheSize);
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<int> pending;
+    std::set<int> active;
+    bool closing = false;
+    std::vector<std::thread> pool;
+    for (size_t worker = 0; worker < workers; ++worker)
+        pool.emplace_back([&]()
+        {
+            Utils::ParallelRegion Region(workers > 1);
+            while (true)
+            {
+                int connection;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    queueReady.wait(lock, [&]() { return closing || !pending.empty(); });
+                    if (pending.empty())
+                        return;
+                    connection = pending.front();
+                    pending.pop_front();
+                    active.insert(connection);
+                }
+                Server::serve(connection, cache);
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex);
+                    active.erase(connection);
+                }
+                close(connection);
+            }
+        });
+
+    // The stop signals stay blocked everywhere and are only delivered inside ppoll, so a signal
+    // arriving between the Stopping check and the wait interrupts the wait instead of being lost.
+    std::cerr << "Listening on " << path << " with " << workers << " workers" << std::endl;
+    while (!Stopping)
+    {
+        pollfd ready = {listener, POLLIN, 0};
+        if (ppoll(&ready, 1, nullptr, &waitMask) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "poll failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        int connection = accept(listener, nullptr, nullptr);
+        if (connection < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN || errno == EWOULDBLOCK)
+                continue;
+            std::cerr << "accept failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending.push_back(connection);
+        queueReady.notify_one();
+    }
+    close(listener);
+    unlink(path.c_str());
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        closing = true;
+        for (int connection : pending)
+            close(connection);
+        pending.clear();
+        for (int connection : active)
+            shutdown(connection, SHUT_RDWR);
+    }
+    queueReady.notify_all();
+    for (std::thread &thread : pool)
+        thread.join();
+    std::cerr << "Context cache: " << cache.hits.load() << " hits, " << cache.misses.load() << " misses" << std::endl;
+    return 0;
+}
+
+ContextCache::ContextCache(size_t capacity) : capacity(capacity), hits(0), misses(0)
+{
+}
+
+ContextCache::ContextPointer ContextCache::get(std::string_view modulus, std::string_view exponent)
+{
+    modulus = BinaryFormat::trim(modulus);
+    exponent = BinaryFormat::trim(exponent);
+    std::string key = std::to_string(modulus.size()) + ':' + std::string(modulus) + std::string(exponent);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = entries.find(key);
+        if (found != entries.end())
+        {
+            order.splice(order.begin(), order, found->second.second);
+            ++hits;
+            return found->second.first;
+        }
+    }
+    ++misses;
+    ContextPointer context = std::make_shared<const MultiBufferModexp::Context>(MultiBufferModexp::prepare(BinaryFormat::toLargeNumber(exponent), BinaryFormat::toLargeNumber(modulus)));
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = entries.find(key);
+    if (found != entries.end())
+        return found->second.first;
+    order.push_front(key);
+    entries.emplace(key, std::make_pair(context, order.begin()));
+    if (entries.size() > capacity)
+    {
+        entries.erase(order.back());
+        order.pop_back();
+    }
+    return context;
+}
+
+std::string Server::handle(std::string_view request, ContextCache &cache)
+{
+    std::vector<ProtocolRecord> records;
+    if (request.size() < 2 || !ServerProtocol::parseRecords(request, 2, records))
+        return std::string(1, char(SERVER_ERROR)) + "Malformed request";
+    try
+    {
+        switch (request[0])
+        {
+        case SERVER_IS_PRIME:
+            return isPrime(records);
+        case SERVER_DERIVE_KEY:
+            return deriveKey(records, request[1] & ServerProtocol::FLAG_CARMICHAEL);
+        case SERVER_ENCRYPT_BATCH:
+            return encryptBatch(records, cache);
+        default:
+            return std::string(1, char(SERVER_ERROR)) + "Unknown operation";
+        }
+    }
+    catch (const char *message)
+    {
+        return std::string(1, char(SERVER_ERROR)) + message;
+    }
+    catch (const std::exception &error)
+    {
+        return std::string(1, char(SERVER_ERROR)) + error.what();
+    }
+}
+
+std::string Server::isPrime(const std::vector<ProtocolRecord> &records)
+{
+    std::string Result(1, char(SERVER_OK));
+    for (const ProtocolRecord &record : records)
+        BinaryFormat::appendInteger(Result, LargeNumberChecking::isPrimeNumber(BinaryFormat::toLargeNumber(record.magnitude)));
+    return Result;
+}
+
+std::string Server::deriveKey(const std::vector<ProtocolRecord> &records, bool useCarmichael)
+{
+    if (records.size() < 2)
+        return std::string(1, char(SERVER_ERROR)) + "deriveKey needs at least one prime and an exponent";
+    LargeNumber One;
+    One.digits[0] = 1;
+    LargeNumber Totient = One;
+    for (size_t i = 0; i + 1 < records.size(); ++i)
+    {
+        LargeNumber PrimeMinusOne = LargeNumberArithmetic::subtractLargeNumbers(BinaryFormat::toLargeNumber(records[i].magnitude), One);
+        if (useCarmichael)
+        {
+            LargeNumber Divisor = LargeNumberSpecialOperations::greatestCommonDivisor(Totient, PrimeMinusOne);
+            Totient = LargeNumberArithmetic::multiplyLargeNumbers(LargeNumberArithmetic::divideByLargeNumber(Totient, Divisor).quotient, PrimeMinusOne);
+        }
+        else
+            Totient = LargeNumberArithmetic::multiplyLargeNumbers(Totient, PrimeMinusOne);
+    }
+    LargeNumber PrivateExponent = LargeNumberSpecialOperations::inverse(BinaryFormat::toLargeNumber(records.back().magnitude), Totient);
+    if (PrivateExponent.is_negative)
+        return std::string(1, char(SERVER_ERROR)) + "exponent not invertible";
+    std::string Result(1, char(SERVER_OK));
+    BinaryFormat::appendLargeNumber(Result, PrivateExponent);
+    return Result;
+}
+
+std::string Server::encryptBatch(const std::vector<ProtocolRecord> &records, ContextCache &cache)
+{
+    if (records.size() < 2)
+        return std::string(1, char(SERVER_ERROR)) + "encryptBatch needs a modulus and an exponent";
+    std::shared_ptr<const MultiBufferModexp::Context> context = cache.get(records[0].magnitude, records[1].magnitude);
+    std::vector<LargeNumber> messages;
+    for (size_t i = 2; i < records.size(); ++i)
+        messages.push_back(BinaryFormat::toLargeNumber(records[i].magnitude));
+    std::string Result(1, char(SERVER_OK));
+    for (const std::string &ciphertext : MultiBufferModexp::exponentiate(*context, messages))
+        BinaryFormat::appendHex(Result, ciphertext);
+    return Result;
+}
+
+void Server::serve(int connection, ContextCache &cache)
+{
+    std::string request;
+    while (ServerProtocol::readFrame(connection, request))
+        if (!ServerProtocol::writeFrame(connection, handle(request, cache)))
+            return;
+}
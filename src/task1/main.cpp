@@ -1,732 +1,234 @@
+#include "rsa_bignum/BatchDriver.h"
+#include "rsa_bignum/BigInteger.h"
+#include "rsa_bignum/BinaryFormat.h"
+#include "rsa_bignum/ConversionOperations.h"
+#include "rsa_bignum/LargeNumberChecking.h"
+#include "rsa_bignum/LatencyHistograms.h"
+#include "rsa_bignum/MappedInput.h"
+#include "rsa_bignum/NumberStore.h"
+#include "rsa_bignum/OperationStats.h"
+#include "rsa_bignum/Pipeline.h"
+#include "rsa_bignum/Trace.h"
+#include "rsa_bignum/Utils.h"
+#include <climits>
+#include <exception>
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <algorithm>
-#include <vector>
+#include <string_view>
 
-struct LargeNumber
+namespace CandidateHandler
 {
-    static const size_t MAX_DIGITS = 309;
-    std::vector<int> digits = std::vector<int>(MAX_DIGITS, 0);
-    bool is_negative = false;
-    LargeNumber() : digits(MAX_DIGITS, 0) {}
-};
-
-struct DivisionResult
-{
-    LargeNumber quotient;
-    LargeNumber remainder;
-};
-
-struct LargeNumberArray
-{
-    LargeNumber result;
-    LargeNumber count;
-};
-
-namespace LargeNumberConversion
-{
-    LargeNumber copyLargeNumber(const LargeNumber &number);
-    LargeNumber addLeadingDigit(const LargeNumber &number, int digit);
-    bool isEqualToZero(const LargeNumber &number);
-}
-
-namespace LargeNumberArithmetic
-{
-    LargeNumber addLargeNumbers(LargeNumber first, LargeNumber second);
-    LargeNumber subtractLargeNumbers(LargeNumber minuend, LargeNumber subtrahend);
-    LargeNumber multiplyLargeNumbers(LargeNumber first, LargeNumber second);
-    DivisionResult divideBySmallNumber(LargeNumber dividend, LargeNumber divisor);
-    DivisionResult divideByLargeNumber(LargeNumber dividend, LargeNumber divisor);
-}
-
-namespace LargeNumberSpecialOperations
-{
-    LargeNumber modularExponentiation(const LargeNumber &base, const LargeNumber &exponent, const LargeNumber &modulus);
-}
-
-namespace LargeNumberChecking
-{
-    bool isPrimeNumber(const LargeNumber &number);
-}
-
-class BigInteger
-{
-private:
-    std::string digits;
-
-public:
-    BigInteger(std::string &);
-    BigInteger(BigInteger &);
-    BigInteger(unsigned long long n = 0);
-    BigInteger(const char *);
-    BigInteger(const BigInteger &a);
-    friend bool Null(const BigInteger &);
-    int operator[](const int) const;
-    std::string toString();
-    BigInteger &operator=(const BigInteger &);
-    BigInteger &operator++();
-    BigInteger operator++(int temp);
-    friend BigInteger &operator+=(BigInteger &, const BigInteger &);
-    friend BigInteger operator+(const BigInteger &, const BigInteger &);
-    BigInteger &operator--();
-    BigInteger operator--(int temp);
-    friend BigInteger &operator-=(BigInteger &, const BigInteger &);
-    friend BigInteger operator-(const BigInteger &, const BigInteger &);
-    friend BigInteger &operator*=(BigInteger &, const BigInteger &);
-    friend BigInteger operator*(const BigInteger &, const BigInteger &);
-    friend BigInteger &operator/=(BigInteger &, const BigInteger &);
-    friend BigInteger operator/(const BigInteger &, const BigInteger &);
-    friend BigInteger operator%(const BigInteger &, const BigInteger &);
-    friend BigInteger &operator%=(BigInteger &, const BigInteger &);
-    friend bool operator==(const BigInteger &, const BigInteger &);
-    friend bool operator<(const BigInteger &, const BigInteger &);
-};
-
-namespace ConversionOperations
-{
-    LargeNumber convertStringToLargeNumber(std::string &str);
-    BigInteger convertHexToDecimal(std::string hexValue);
+    bool checkCandidate(std::string_view candidate, bool binary);
+    void checkFile(const std::string &inputPath, const std::string &outputPath);
+    void processFile(const std::string &inputPath, const std::string &outputPath, bool batchMode, size_t workers);
+    bool checkBatch(const char *inputPath, const char *outputPath, size_t workers);
+    bool checkStore(const char *inputPath, std::ofstream &output, size_t workers);
 }
 
 int main(int argc, char **argv)
 {
-    std::string hexInput;
-    int outputResult;
-    BigInteger decimalValue;
-    std::string testFileId;
+    int status = 0;
     if (argc < 3)
         std::cout << "Not enough Command Line Arguments passed!" << std::endl;
     else
     {
-        std::ifstream inputTestFile(argv[1]);
-        inputTestFile >> hexInput;
-        inputTestFile.close();
-        decimalValue = ConversionOperations::convertHexToDecimal(hexInput);
-        LargeNumber largeNumber;
-        std::string largeNumberStr = decimalValue.toString();
-        largeNumber = ConversionOperations::convertStringToLargeNumber(largeNumberStr);
-        int result;
-        result = LargeNumberChecking::isPrimeNumber(largeNumber);
-        std::ofstream outputTestFile(argv[2]);
-        outputTestFile << result;
-        outputTestFile.close();
-    }
-    return 0;
-}
-
-LargeNumber LargeNumberConversion::copyLargeNumber(const LargeNumber &number)
-{
-    LargeNumber Result;
-    Result.is_negative = number.is_negative;
-    for (int i = 0; i < Result.MAX_DIGITS; i++)
-        Result.digits[i] = number.digits[i];
-    return Result;
-}
-
-LargeNumber LargeNumberConversion::addLeadingDigit(const LargeNumber &number, int digit)
-{
-    LargeNumber Result = number;
-    Result.is_negative = number.is_negative;
-    for (int i = Result.MAX_DIGITS - 1; i > 0; --i)
-        Result.digits[i] = Result.digits[i - 1];
-    Result.digits[0] = digit;
-    return Result;
-}
-
-bool LargeNumberConversion::isEqualToZero(const LargeNumber &number)
-{
-    for (int i = 0; i < number.MAX_DIGITS; i++)
-        if (number.digits[i] != 0)
-            return false;
-    return true;
-}
-
-LargeNumber LargeNumberArithmetic::addLargeNumbers(LargeNumber first, LargeNumber second)
-{
-    if (LargeNumberConversion::isEqualToZero(first))
-        return second;
-    if (LargeNumberConversion::isEqualToZero(second))
-        return first;
-    bool BothNegative = first.is_negative && second.is_negative;
-    if (first.is_negative)
-    {
-        first.is_negative = false;
-        return subtractLargeNumbers(second, first);
-    }
-    if (second.is_negative)
-    {
-        second.is_negative = false;
-        return subtractLargeNumbers(first, second);
-    }
-    LargeNumber Result;
-    int carry = 0;
-    for (int i = 0; i < Result.MAX_DIGITS; i++)
-    {
-        int sum = first.digits[i] + second.digits[i] + carry;
-        Result.digits[i] = sum % 100;
-        carry = sum / 100;
-    }
-    if (carry)
-        Result.digits[Result.MAX_DIGITS - 1] = carry;
-    Result.is_negative = BothNegative;
-    return Result;
-}
-
-LargeNumber LargeNumberArithmetic::subtractLargeNumbers(LargeNumber minuend, LargeNumber subtrahend)
-{
-    if (LargeNumberConversion::isEqualToZero(subtrahend))
-        return minuend;
-    if (LargeNumberConversion::isEqualToZero(minuend))
-    {
-        subtrahend.is_negative = true;
-        return subtrahend;
-    }
-    if (subtrahend.is_negative)
-    {
-        if (minuend.is_negative)
+        std::string tracePath;
+        bool batchMode = false, directoryMode = false;
+        size_t latencyInterval = 0, workers = 0;
+        BatchOptions batchOptions;
+        for (int i = 3; i < argc; ++i)
         {
-            minuend.is_negative = subtrahend.is_negative = false;
-            return subtractLargeNumbers(subtrahend, minuend);
+            if (std::string(argv[i]) == "--stats")
+                OperationStats::enabled = true;
+            else if (std::string(argv[i]) == "--batch")
+                batchMode = true;
+            else if (std::string(argv[i]) == "--dir")
+                directoryMode = true;
+            else if (std::string(argv[i]) == "--jobs" && i + 1 < argc && Utils::parseCount(argv[i + 1], batchOptions.threads))
+                ++i;
+            else if (std::string(argv[i]) == "--processes" && i + 1 < argc && Utils::parseCount(argv[i + 1], batchOptions.processes))
+                ++i;
+            else if (std::string(argv[i]) == "--numa")
+                batchOptions.pinNuma = true;
+            else if (std::string(argv[i]) == "--workers" && i + 1 < argc && Utils::parseCount(argv[i + 1], workers))
+                ++i;
+            else if (std::string(argv[i]) == "--latency")
+                LatencyHistograms::enabled = true;
+            else if (std::string(argv[i]) == "--latency-interval" && i + 1 < argc && Utils::parseCount(argv[i + 1], latencyInterval, UINT_MAX))
+            {
+                LatencyHistograms::enabled = true;
+                ++i;
+            }
+            else if (std::string(argv[i]) == "--trace" && i + 1 < argc)
+                tracePath = argv[++i];
+            else
+            {
+                std::cerr << "Usage: <input_file> <output_file> [--batch [--workers count]] [--dir [--jobs count] [--processes count [--numa]]] [--stats] [--latency] [--latency-interval seconds] [--trace file]" << std::endl;
+                return 1;
+            }
         }
-        subtrahend.is_negative = false;
-        return addLargeNumbers(minuend, subtrahend);
-    }
-    if (minuend.is_negative)
-    {
-        minuend.is_negative = subtrahend.is_negative = false;
-        LargeNumber result = addLargeNumbers(minuend, subtrahend);
-        result.is_negative = true;
-        return result;
-    }
-    LargeNumber Result = minuend;
-    bool borrow = false;
-    for (int i = 0; i < Result.MAX_DIGITS; i++)
-    {
-        int diff = Result.digits[i] - subtrahend.digits[i] - borrow;
-        if (diff < 0)
+        if (batchOptions.processes && (OperationStats::enabled || LatencyHistograms::enabled || !tracePath.empty()))
         {
-            diff += 100;
-            borrow = true;
+            std::cerr << "--stats, --latency and --trace only see the parent process and cannot be combined with --processes" << std::endl;
+            return 1;
         }
-        else
-            borrow = false;
-        Result.digits[i] = diff;
-    }
-    if (borrow)
-    {
-        LargeNumber temp = subtractLargeNumbers(subtrahend, minuend);
-        temp.is_negative = true;
-        return temp;
-    }
-    return Result;
-}
-
-LargeNumber LargeNumberArithmetic::multiplyLargeNumbers(LargeNumber first, LargeNumber second)
-{
-    if (LargeNumberConversion::isEqualToZero(first) || LargeNumberConversion::isEqualToZero(second))
-        return LargeNumber();
-    bool neg = first.is_negative ^ second.is_negative;
-    first.is_negative = second.is_negative = false;
-    LargeNumber Result;
-    for (int i = 0; i < Result.MAX_DIGITS; i++)
-    {
-        LargeNumber temp;
-        int carry = 0;
-        for (int j = 0; j < Result.MAX_DIGITS; j++)
+        if (!tracePath.empty())
+            Trace::enable();
+        LatencyHistograms::startReporter(std::cerr, latencyInterval);
+        try
         {
-            int val = first.digits[i] * second.digits[j] + carry;
-            carry = val / 100;
-            temp.digits[j] += val % 100;
+            if (directoryMode)
+            {
+                auto task = [&](const std::string &inputPath, const std::string &outputPath)
+                {
+                    CandidateHandler::processFile(inputPath, outputPath, batchMode, workers ? workers : 1);
+                };
+                if (!BatchDriver::processDirectory(argv[1], argv[2], task, batchOptions, std::cerr))
+                    status = 1;
+            }
+            else
+                CandidateHandler::processFile(argv[1], argv[2], batchMode, workers);
         }
-        for (int k = Result.MAX_DIGITS - 1; k >= i; k--)
-            temp.digits[k] = temp.digits[k - i];
-        for (int k = 0; k < i; k++)
-            temp.digits[k] = 0;
-        Result = addLargeNumbers(Result, temp);
+        catch (const char *message)
+        {
+            std::cerr << message << std::endl;
+            status = 1;
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+            status = 1;
+        }
+        LatencyHistograms::stopReporter();
+        if (OperationStats::enabled)
+            OperationStats::print(std::cerr);
+        if (LatencyHistograms::enabled)
+            LatencyHistograms::print(std::cerr);
+        if (!tracePath.empty() && !Trace::write(tracePath))
+            std::cerr << "Failed to write trace file " << tracePath << std::endl;
     }
-    Result.is_negative = neg;
-    return Result;
+    return status;
 }
 
-DivisionResult LargeNumberArithmetic::divideBySmallNumber(LargeNumber dividend, LargeNumber divisor)
+bool CandidateHandler::checkCandidate(std::string_view candidate, bool binary)
 {
-    DivisionResult Result;
-    if (LargeNumberConversion::isEqualToZero(dividend))
-    {
-        Result.quotient = dividend;
-        Result.remainder = dividend;
-        return Result;
-    }
-    LargeNumber countArray, One, tempResult = dividend;
-    One.digits[0] = 1;
-    bool CheckNeg = tempResult.is_negative;
-    do
+    LargeNumber largeNumber;
+    if (binary)
     {
-        tempResult = subtractLargeNumbers(tempResult, divisor);
-        CheckNeg = tempResult.is_negative;
-        if (countArray.digits[0] != 99)
-            countArray.digits[0] = countArray.digits[0] + 1;
-        else
-            countArray = addLargeNumbers(countArray, One);
-    } while (!CheckNeg);
-    if (countArray.digits[0] != 0)
-    {
-        countArray.digits[0] = countArray.digits[0] - 1;
-        Result.quotient = countArray;
+        TraceSpan Span("BinaryFormat::toLargeNumber", "conversion");
+        largeNumber = BinaryFormat::toLargeNumber(candidate);
     }
     else
-        Result.quotient = subtractLargeNumbers(countArray, One);
-    Result.remainder = addLargeNumbers(tempResult, divisor);
-    return Result;
-}
-
-DivisionResult LargeNumberArithmetic::divideByLargeNumber(LargeNumber dividend, LargeNumber divisor)
-{
-    DivisionResult Result, tempResult;
-    LargeNumber partOffirst, test;
-    if (LargeNumberConversion::isEqualToZero(dividend))
-    {
-        Result.quotient = dividend;
-        Result.remainder = dividend;
-    }
-    bool neg = false;
-    if (dividend.is_negative && divisor.is_negative)
-    {
-        dividend.is_negative = false;
-        divisor.is_negative = false;
-    }
-    else if (dividend.is_negative)
-    {
-        dividend.is_negative = false;
-        neg = true;
-    }
-    else if (divisor.is_negative)
-    {
-        divisor.is_negative = false;
-        neg = true;
-    }
-    std::reverse(std::begin(dividend.digits), std::end(dividend.digits));
-    int i = 0;
-    while (i != 309)
     {
-        do
-        {
-            partOffirst = LargeNumberConversion::addLeadingDigit(partOffirst, dividend.digits[i]);
-            test = subtractLargeNumbers(partOffirst, divisor);
-            i++;
-        } while (test.is_negative && i != 309);
-        tempResult = divideBySmallNumber(partOffirst, divisor);
-        Result.quotient.digits[309 - i] = tempResult.quotient.digits[0];
-        partOffirst = tempResult.remainder;
+        TraceSpan Span("convertHexBigEndianToDecimal", "conversion");
+        BigInteger decimalValue = ConversionOperations::convertHexBigEndianToDecimal(candidate);
+        std::string largeNumberStr = decimalValue.toString();
+        largeNumber = ConversionOperations::convertStringToLargeNumber(largeNumberStr);
     }
-    Result.remainder = partOffirst;
-    Result.remainder.is_negative = neg;
-    Result.quotient.is_negative = neg;
-    return Result;
+    return LargeNumberChecking::isPrimeNumber(largeNumber);
 }
 
-LargeNumber LargeNumberSpecialOperations::modularExponentiation(const LargeNumber &base, const LargeNumber &exponent, const LargeNumber &modulus)
+void CandidateHandler::checkFile(const std::string &inputPath, const std::string &outputPath)
 {
-    if (LargeNumberConversion::isEqualToZero(base))
-        return base;
-    if (LargeNumberConversion::isEqualToZero(exponent))
+    MappedInput input;
+    std::string_view candidate;
     {
-        LargeNumber result;
-        result.digits[0] = 1;
-        return result;
-    }
-    LargeNumber Result, Base, Exp;
-    Result.digits[0] = 1;
-    Base = LargeNumberConversion::copyLargeNumber(base);
-    Exp = LargeNumberConversion::copyLargeNumber(exponent);
-    DivisionResult DR = LargeNumberArithmetic::divideByLargeNumber(Base, modulus);
-    Base = DR.remainder;
-    while (!LargeNumberConversion::isEqualToZero(Exp))
-    {
-        if (Exp.digits[0] % 2 == 1)
+        TraceSpan Span("readInput", "io");
+        if (input.open(inputPath))
         {
-            Result = LargeNumberArithmetic::multiplyLargeNumbers(Result, Base);
-            DR = LargeNumberArithmetic::divideByLargeNumber(Result, modulus);
-            Result = DR.remainder;
+            if (!input.matchesRecordType(RECORD_CANDIDATES))
+                throw("Binary Format Error: Input Is Not A Candidates File");
+            input.next(candidate);
         }
-        Base = LargeNumberArithmetic::multiplyLargeNumbers(Base, Base);
-        DR = LargeNumberArithmetic::divideByLargeNumber(Base, modulus);
-        Base = DR.remainder;
-        LargeNumber tmp;
-        tmp.digits[0] = 2;
-        Exp = LargeNumberArithmetic::divideByLargeNumber(Exp, tmp).quotient;
     }
-    return Result;
-}
-
-bool LargeNumberChecking::isPrimeNumber(const LargeNumber &inputNumber)
-{
-    LargeNumber number = LargeNumberConversion::copyLargeNumber(inputNumber);
-    LargeNumber one, two, base, numberMinusOne, exponentK, calcResult, remainder;
-    one.digits[0] = 1;
-    two.digits[0] = 2;
-    base.digits[0] = 2;
-    if (LargeNumberArithmetic::subtractLargeNumbers(number, base).is_negative)
-        return false;
-    DivisionResult divisionResult = LargeNumberArithmetic::divideByLargeNumber(number, two);
-    if (LargeNumberConversion::isEqualToZero(divisionResult.remainder))
-        return false;
-    numberMinusOne = LargeNumberArithmetic::subtractLargeNumbers(number, one);
-    exponentK.digits[0] = 0;
-    while (!LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::divideByLargeNumber(numberMinusOne, two).remainder))
+    int result = checkCandidate(candidate, input.isBinary());
+    TraceSpan Span("writeOutput", "io");
+    std::ofstream outputTestFile(outputPath, std::ios::binary);
+    if (input.isBinary())
     {
-        numberMinusOne = LargeNumberArithmetic::divideByLargeNumber(numberMinusOne, two).quotient;
-        exponentK.digits[0]++;
+        std::string record = BinaryFormat::header(RECORD_PRIMALITY_RESULTS, 1);
+        BinaryFormat::appendInteger(record, result);
+        outputTestFile << record;
     }
-    calcResult = LargeNumberSpecialOperations::modularExponentiation(base, numberMinusOne, number);
-    divisionResult = LargeNumberArithmetic::divideByLargeNumber(calcResult, number);
-    if (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(divisionResult.remainder, one)) ||
-        LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(divisionResult.remainder, numberMinusOne)))
-        return true;
-    LargeNumber currentExponent = one;
-    while (!LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(exponentK, currentExponent)))
-    {
-        calcResult = LargeNumberSpecialOperations::modularExponentiation(calcResult, two, number);
-        divisionResult = LargeNumberArithmetic::divideByLargeNumber(calcResult, number);
-        if (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(divisionResult.remainder, one)))
-            return false;
-        if (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(divisionResult.remainder, numberMinusOne)))
-            return true;
-        currentExponent = LargeNumberArithmetic::addLargeNumbers(currentExponent, one);
-    }
-    return false;
-}
-
-BigInteger::BigInteger(std::string &s)
-{
-    digits = "";
-    int n = s.size();
-    for (int i = n - 1; i >= 0; i--)
-    {
-        if (!isdigit(s[i]))
-            throw("ERROR CONVERT");
-        else
-            digits.push_back(s[i] - '0');
-    }
-}
-
-BigInteger::BigInteger(unsigned long long numConvert)
-{
-    do
-    {
-        digits.push_back(numConvert % 10);
-        numConvert /= 10;
-    } while (numConvert != 0);
-}
-
-BigInteger::BigInteger(const char *s)
-{
-    std::string str = std::string(s);
-    digits = "";
-    for (int i = str.length() - 1; i >= 0; i--)
-    {
-        if (!isdigit(s[i]))
-            throw("ERROR CONVERT");
-        else
-            digits.push_back(s[i] - '0');
-    }
-}
-
-BigInteger::BigInteger(BigInteger &a)
-{
-    digits = a.digits;
-}
-
-BigInteger::BigInteger(const BigInteger &a)
-{
-    this->digits = a.digits;
-}
-
-bool Null(const BigInteger &a)
-{
-    return (a.digits.size() == 1 && a.digits[0] == 0);
-}
-
-int BigInteger::operator[](const int index) const
-{
-    if (digits.size() <= index || index < 0)
-        throw("ERROR");
-    return digits[index];
-}
-
-BigInteger &BigInteger::operator=(const BigInteger &a)
-{
-    digits = a.digits;
-    return *this;
-}
-
-BigInteger &BigInteger::operator++()
-{
-    int i, n = digits.size();
-    for (i = 0; i < n && digits[i] == 9; i++)
-        digits[i] = 0;
-    if (i == n)
-        digits.push_back(1);
     else
-        digits[i]++;
-    return *this;
-}
-
-BigInteger BigInteger::operator++(int temp)
-{
-    BigInteger aux;
-    aux = *this;
-    ++(*this);
-    return aux;
-}
-
-BigInteger &operator+=(BigInteger &a, const BigInteger &b)
-{
-    int carry = 0, sum;
-    size_t n = a.digits.size(), m = b.digits.size();
-    if (m > n)
-        a.digits.resize(m, 0);
-    for (size_t i = 0; i < m || carry; ++i)
-    {
-        if (i == a.digits.size())
-            a.digits.push_back(0);
-        sum = a.digits[i] + carry + (i < m ? b.digits[i] : 0);
-        a.digits[i] = sum % 10;
-        carry = sum / 10;
-    }
-    return a;
-}
-
-BigInteger operator+(const BigInteger &a, const BigInteger &b)
-{
-    BigInteger temp(a);
-    temp += b;
-    return temp;
-}
-
-BigInteger &BigInteger::operator--()
-{
-    if (digits[0] == 0 && digits.size() == 1)
-        throw("UNDERFLOW");
-    int i, n = digits.size();
-    for (i = 0; digits[i] == 0 && i < n; i++)
-        digits[i] = 9;
-    digits[i]--;
-    if (n > 1 && digits[n - 1] == 0)
-        digits.pop_back();
-    return *this;
-}
-
-BigInteger BigInteger::operator--(int temp)
-{
-    BigInteger aux;
-    aux = *this;
-    --(*this);
-    return aux;
-}
-
-BigInteger &operator-=(BigInteger &a, const BigInteger &b)
-{
-    if (a < b)
-        throw("UNDERFLOW");
-    int n = a.digits.size(), m = b.digits.size(), t = 0;
-    for (int i = 0; i < n; i++)
-    {
-        int s = a.digits[i] - (i < m ? b.digits[i] : 0) + t;
-        t = s < 0 ? -1 : 0;
-        a.digits[i] = s < 0 ? s + 10 : s;
-    }
-    while (n > 1 && a.digits[n - 1] == 0)
-        a.digits.pop_back(), n--;
-    return a;
-}
-
-BigInteger operator-(const BigInteger &a, const BigInteger &b)
-{
-    BigInteger temp;
-    temp = a;
-    temp -= b;
-    return temp;
-}
-
-BigInteger operator*(const BigInteger &a, const BigInteger &b)
-{
-    BigInteger temp;
-    temp = a;
-    temp *= b;
-    return temp;
+        outputTestFile << result;
 }
 
-BigInteger &operator*=(BigInteger &a, const BigInteger &b)
+void CandidateHandler::processFile(const std::string &inputPath, const std::string &outputPath, bool batchMode, size_t workers)
 {
-    if (Null(a) || Null(b))
-    {
-        a = BigInteger();
-        return a;
-    }
-    int n = a.digits.size(), m = b.digits.size();
-    std::vector<int> v(n + m, 0);
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < m; j++)
-            v[i + j] += a.digits[i] * b.digits[j];
-    a.digits.resize(n + m);
-    int carry = 0;
-    for (int i = 0; i < a.digits.size(); i++)
-    {
-        v[i] += carry;
-        a.digits[i] = v[i] % 10;
-        carry = v[i] / 10;
-    }
-    while (a.digits.size() > 1 && a.digits.back() == 0)
-        a.digits.pop_back();
-    return a;
+    if (!batchMode)
+        checkFile(inputPath, outputPath);
+    else if (!checkBatch(inputPath.c_str(), outputPath.c_str(), workers))
+        throw("Failed to open input or output file.");
 }
 
-BigInteger &operator/=(BigInteger &a, const BigInteger &b)
+bool CandidateHandler::checkBatch(const char *inputPath, const char *outputPath, size_t workers)
 {
-    if (Null(b))
-        throw("Arithmetic Error: Division By 0");
-    if (a < b)
-    {
-        a = BigInteger();
-        return a;
-    }
-    int n = a.digits.size(), m = b.digits.size();
-    std::vector<int> quotient(n, 0);
-    BigInteger temp;
-    for (int i = n - 1; i >= 0; --i)
-    {
-        temp = temp * 10 + a.digits[i];
-        int divisor = 0;
-        while (b < temp || b == temp)
+    MappedInput input;
+    if (!input.open(inputPath))
+        return false;
+    if (!input.matchesRecordType(RECORD_CANDIDATES))
+        throw("Binary Format Error: Input Is Not A Candidates File");
+    std::ofstream output(outputPath, std::ios::binary);
+    if (!output.is_open())
+        return false;
+    if (NumberStore::isStore(input.contents()))
+        return checkStore(inputPath, output, workers);
+    const bool binary = input.isBinary();
+    if (binary)
+        output << BinaryFormat::header(RECORD_PRIMALITY_RESULTS, input.recordCount());
+    Pipeline::run<std::string_view, int>(
+        [&](std::string_view &candidate)
         {
-            temp -= b;
-            ++divisor;
-        }
-        quotient[n - i - 1] = divisor;
-    }
-    a.digits.clear();
-    for (int digit : quotient)
-        a.digits.push_back(digit);
-    return a;
-}
-
-BigInteger operator/(const BigInteger &a, const BigInteger &b)
-{
-    BigInteger temp;
-    temp = a;
-    temp /= b;
-    return temp;
+            TraceSpan Span("readCandidate", "io");
+            return input.next(candidate);
+        },
+        [binary](std::string_view &candidate)
+        {
+            TraceSpan Span("candidate", "message");
+            return int(checkCandidate(candidate, binary));
+        },
+        [&](int &result)
+        {
+            TraceSpan Span("writeResult", "io");
+            if (binary)
+            {
+                std::string record;
+                BinaryFormat::appendInteger(record, result);
+                output << record;
+            }
+            else
+                output << result << '\n';
+        },
+        workers);
+    return true;
 }
 
-BigInteger &operator%=(BigInteger &a, const BigInteger &b)
+bool CandidateHandler::checkStore(const char *inputPath, std::ofstream &output, size_t workers)
 {
-    if (Null(b))
-        throw("Arithmetic Error: Division By 0");
-    if (a < b)
-        return a;
-    if (a == b)
-    {
-        a = BigInteger();
-        return a;
-    }
-    int n = a.digits.size();
-    BigInteger t;
-    for (int i = n - 1; t * 10 + a.digits[i] < b; i--)
+    NumberStore store;
+    if (!store.open(inputPath) || !store.verify())
     {
-        t *= 10;
-        t += a.digits[i];
+        std::cerr << "Number store " << inputPath << " is malformed or fails its checksum." << std::endl;
+        return false;
     }
-    for (int i = n - 1; i >= 0; i--)
-    {
-        t = t * 10 + a.digits[i];
-        int cc = 0;
-        while (b < t || b == t)
+    size_t next = 0;
+    Pipeline::run<size_t, int>(
+        [&](size_t &position)
         {
-            t -= b;
-            ++cc;
-        }
-    }
-    a = t;
-    return a;
-}
-
-BigInteger operator%(const BigInteger &a, const BigInteger &b)
-{
-    BigInteger temp;
-    temp = a;
-    temp %= b;
-    return temp;
-}
-
-std::string BigInteger::toString()
-{
-    std::string res = "";
-    for (int i = this->digits.size() - 1; i >= 0; i--)
-        res = res + std::to_string((short)this->digits[i]);
-    return res;
-}
-
-bool operator==(const BigInteger &a, const BigInteger &b)
-{
-    return a.digits == b.digits;
-}
-
-bool operator<(const BigInteger &a, const BigInteger &b)
-{
-    size_t n = a.digits.size(), m = b.digits.size();
-    if (n != m)
-        return n < m;
-    for (size_t i = n; i-- > 0;)
-        if (a.digits[i] != b.digits[i])
-            return a.digits[i] < b.digits[i];
-    return false;
-}
-
-BigInteger ConversionOperations::convertHexToDecimal(std::string hexValue)
-{
-    std::reverse(hexValue.begin(), hexValue.end());
-    int length = hexValue.size();
-    BigInteger base("1");
-    BigInteger decimalValue("0");
-    for (int i = 0; i < length; i++)
-    {
-        if (hexValue[i] >= '0' && hexValue[i] <= '9')
+            position = next;
+            return next++ < store.size();
+        },
+        [&](size_t &position)
         {
-            decimalValue += (hexValue[i] - '0') * base;
-            base = base * 16;
-        }
-        else if (hexValue[i] >= 'A' && hexValue[i] <= 'F')
+            TraceSpan Span("candidate", "message", position);
+            return int(LargeNumberChecking::isPrimeNumber(store[position].toLargeNumber()));
+        },
+        [&](int &result)
         {
-            decimalValue += (hexValue[i] - '7') * base;
-            base = base * 16;
-        }
-    }
-    return decimalValue;
+            output << result << '\n';
+        },
+        workers);
+    return true;
 }
-
-LargeNumber ConversionOperations::convertStringToLargeNumber(std::string &str)
-{
-    LargeNumber final;
-    bool neg = (str[0] == '-');
-    if (neg)
-        str.erase(0, 1);
-    reverse(begin(str), end(str));
-    int val = 0, itr = 1, Out = 0;
-    for (char c : str)
-    {
-        val += (c - '0') * itr;
-        itr *= 10;
-        if (itr == 100)
-        {
-            final.digits[Out++] = val;
-            itr = 1;
-            val = 0;
-        }
-    }
-    if (val)
-        final.digits[Out] = val;
-    final.is_negative = neg;
-    return final;
-}
\ No newline at end of file
@@ -1,12 +1,27 @@
+#include "rsa_bignum/BatchDriver.h"
+#include "rsa_bignum/BinaryFormat.h"
+#include "rsa_bignum/ConversionOperations.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include "rsa_bignum/LargeNumberSpecialOperations.h"
+#include "rsa_bignum/LatencyHistograms.h"
+#include "rsa_bignum/MappedInput.h"
+#include "rsa_bignum/OperationStats.h"
+#include "rsa_bignum/Pipeline.h"
+#include "rsa_bignum/Trace.h"
+#include "rsa_bignum/Utils.h"
+#include <climits>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <algorithm>
 #include <vector>
+#include <iterator>
+#include <map>
 
 namespace IOHandler {
-    std::vector<std::string> readInputFile(const std::string &filePath);
+    std::vector<std::string> readInputFile(const std::string &filePath, bool &binary);
     bool writeOutputFile(const std::string &filePath, const std::string &content);
+    void processFile(const std::string &inputFile, const std::string &outputFile, bool useCarmichael, bool includeCrt, bool batchMode, size_t workers);
 };
 
 namespace HelperFunctions {
@@ -15,129 +30,120 @@ namespace HelperFunctions {
     bool areHexadecimal(const std::vector<std::string> &values);
 }
 
-struct LargeNumber
+struct MultiPrimeKey
 {
-    static const size_t MAX_DIGITS = 309;
-    std::vector<int> digits = std::vector<int>(MAX_DIGITS, 0);
-    bool is_negative = false;
-    LargeNumber() : digits(MAX_DIGITS, 0) {}
-    LargeNumber(const std::vector<int> &input_digits) : digits(input_digits) {}
-};
-
-struct DivisionResult
-{
-    LargeNumber quotient;
-    LargeNumber remainder;
+    LargeNumber modulus;
+    LargeNumber privateExponent;
+    std::vector<LargeNumber> primes;
+    std::vector<LargeNumber> exponents;
+    std::vector<LargeNumber> coefficients;
 };
 
 namespace HandlerLargeNumbers
 {
     LargeNumber processLargeNumbers(const std::string &hexP, const std::string &hexQ, const std::string &hexE);
+    MultiPrimeKey processMultiPrimeNumbers(const std::vector<std::string> &primeValues, const std::string &exponentValue, bool binary, bool useCarmichael, bool includeCrt);
+    LargeNumber parseValue(const std::string &value, bool binary);
+    std::vector<std::vector<size_t>> groupByModulus(const std::vector<std::string> &values);
+    void processKeyGroup(const std::vector<std::string> &values, const std::vector<size_t> &keys, bool binary, bool useCarmichael, std::vector<LargeNumber> &inverses);
+    LargeNumber computeTotient(const std::vector<LargeNumber> &primes, bool useCarmichael);
     std::string formatLargeNumber(const LargeNumber &number);
+    std::string formatMultiPrimeKey(const MultiPrimeKey &key);
+    std::string formatBatch(const std::vector<LargeNumber> &numbers);
+    std::string encodeMultiPrimeKey(const MultiPrimeKey &key, bool includeCrt);
+    std::string encodeBatch(const std::vector<LargeNumber> &numbers);
+    bool writeBatch(const std::vector<std::string> &values, bool useCarmichael, bool binary, const std::string &filePath, size_t workers);
 }
 
-namespace LargeNumberConversion
-{
-    LargeNumber copyLargeNumber(const LargeNumber &number);
-    LargeNumber addLeadingDigit(const LargeNumber &number, int digit);
-    bool isEqualToZero(const LargeNumber &number);
-}
-
-namespace LargeNumberArithmetic
-{
-    LargeNumber addLargeNumbers(LargeNumber first, LargeNumber second);
-    LargeNumber subtractLargeNumbers(LargeNumber minuend, LargeNumber subtrahend);
-    LargeNumber multiplyLargeNumbers(LargeNumber first, LargeNumber second);
-    DivisionResult divideBySmallNumber(LargeNumber dividend, LargeNumber divisor);
-    DivisionResult divideByLargeNumber(LargeNumber dividend, LargeNumber divisor);
-}
-
-namespace LargeNumberSpecialOperations
-{
-    LargeNumber inverse(LargeNumber number, LargeNumber modulus);
-}
-
-struct LargeNumberArray
-{
-    LargeNumber result;
-    LargeNumber count;
-};
-
-class BigInteger
-{
-private:
-    std::string digits;
-public:
-    BigInteger(std::string &);
-    BigInteger(BigInteger &);
-    BigInteger(unsigned long long n = 0);
-    BigInteger(const char *);
-    BigInteger(const BigInteger &a);
-    friend bool Null(const BigInteger &);
-    int operator[](const int) const;
-    std::string toString();
-    BigInteger &operator=(const BigInteger &);
-    BigInteger &operator++();
-    BigInteger operator++(int temp);
-    friend BigInteger &operator+=(BigInteger &, const BigInteger &);
-    friend BigInteger operator+(const BigInteger &, const BigInteger &);
-    BigInteger &operator--();
-    BigInteger operator--(int temp);
-    friend BigInteger &operator-=(BigInteger &, const BigInteger &);
-    friend BigInteger operator-(const BigInteger &, const BigInteger &);
-    friend BigInteger &operator*=(BigInteger &, const BigInteger &);
-    friend BigInteger operator*(const BigInteger &, const BigInteger &);
-    friend BigInteger &operator/=(BigInteger &, const BigInteger &);
-    friend BigInteger operator/(const BigInteger &, const BigInteger &);
-    friend BigInteger operator%(const BigInteger &, const BigInteger &);
-    friend BigInteger &operator%=(BigInteger &, const BigInteger &);
-    friend bool operator==(const BigInteger &, const BigInteger &);
-    friend bool operator<(const BigInteger &, const BigInteger &);
-};
-
-namespace ConversionOperations
-{
-    LargeNumber convertStringToLargeNumber(const std::string &str);
-    std::string convertDecimalToHexBigEndian(LargeNumber decimal);
-    BigInteger convertHexBigEndianToDecimal(std::string hexVal);
-    std::string convertLargeNumberToString(LargeNumber input);
-};
-
 int main(int argc, char **argv)
 {
+    const char *usage = "Usage: <input_file> <output_file> [--lambda] [--crt] [--batch [--workers count]] [--dir [--jobs count] [--processes count [--numa]]] [--stats] [--latency] [--latency-interval seconds] [--trace file]";
     if (argc < 3)
     {
-        std::cerr << "Usage: <input_file> <output_file>" << std::endl;
+        std::cerr << usage << std::endl;
         return 1;
     }
     const std::string inputFile = argv[1];
     const std::string outputFile = argv[2];
-    if (!HelperFunctions::validateFile(inputFile))
-    {
-        std::cerr << "Error: Invalid input file!" << std::endl;
-        return 1;
+    bool useCarmichael = false, includeCrt = false, batchMode = false, directoryMode = false;
+    std::string tracePath;
+    size_t latencyInterval = 0, workers = 0;
+    BatchOptions batchOptions;
+    for (int i = 3; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        if (option == "--lambda")
+            useCarmichael = true;
+        else if (option == "--crt")
+            includeCrt = true;
+        else if (option == "--batch")
+            batchMode = true;
+        else if (option == "--dir")
+            directoryMode = true;
+        else if (option == "--jobs" && i + 1 < argc && Utils::parseCount(argv[i + 1], batchOptions.threads))
+            ++i;
+        else if (option == "--processes" && i + 1 < argc && Utils::parseCount(argv[i + 1], batchOptions.processes))
+            ++i;
+        else if (option == "--numa")
+            batchOptions.pinNuma = true;
+        else if (option == "--workers" && i + 1 < argc && Utils::parseCount(argv[i + 1], workers))
+            ++i;
+        else if (option == "--stats")
+            OperationStats::enabled = true;
+        else if (option == "--latency")
+            LatencyHistograms::enabled = true;
+        else if (option == "--latency-interval" && i + 1 < argc && Utils::parseCount(argv[i + 1], latencyInterval, UINT_MAX))
+        {
+            LatencyHistograms::enabled = true;
+            ++i;
+        }
+        else if (option == "--trace" && i + 1 < argc)
+            tracePath = argv[++i];
+        else
+        {
+            std::cerr << "Error: Unknown option or invalid value " << option << '\n' << usage << std::endl;
+            return 1;
+        }
     }
-    std::vector<std::string> hexValues = IOHandler::readInputFile(inputFile);
-    if (hexValues.size() != 3 || !HelperFunctions::areHexadecimal(hexValues))
+    if (batchOptions.processes && (OperationStats::enabled || LatencyHistograms::enabled || !tracePath.empty()))
     {
-        std::cerr << "Error: Non-hexadecimal or incomplete input values!" << std::endl;
+        std::cerr << "Error: --stats, --latency and --trace only see the parent process and cannot be combined with --processes" << std::endl;
         return 1;
     }
+    if (!tracePath.empty())
+        Trace::enable();
+    LatencyHistograms::startReporter(std::cerr, latencyInterval);
     try
     {
-        LargeNumber D = HandlerLargeNumbers::processLargeNumbers(hexValues[0], hexValues[1], hexValues[2]);
-        std::string output = HandlerLargeNumbers::formatLargeNumber(D);
-        if (!IOHandler::writeOutputFile(outputFile, output))
+        if (directoryMode)
         {
-            std::cerr << "Error: Unable to write to output file!" << std::endl;
-            return 1;
+            auto task = [&](const std::string &inputPath, const std::string &outputPath)
+            {
+                IOHandler::processFile(inputPath, outputPath, useCarmichael, includeCrt, batchMode, workers ? workers : 1);
+            };
+            if (!BatchDriver::processDirectory(inputFile, outputFile, task, batchOptions, std::cerr))
+                return 1;
         }
+        else
+            IOHandler::processFile(inputFile, outputFile, useCarmichael, includeCrt, batchMode, workers);
+    }
+    catch (const char *message)
+    {
+        std::cerr << "Error: " << message << std::endl;
+        return 1;
     }
     catch (const std::exception &e)
     {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
     }
+    LatencyHistograms::stopReporter();
+    if (OperationStats::enabled)
+        OperationStats::print(std::cerr);
+    if (LatencyHistograms::enabled)
+        LatencyHistograms::print(std::cerr);
+    if (!tracePath.empty() && !Trace::write(tracePath))
+        std::cerr << "Error: Unable to write trace file!" << std::endl;
     return 0;
 }
 
@@ -147,17 +153,54 @@ bool HelperFunctions::validateFile(const std::string &filename)
     return file.good();
 }
 
-std::vector<std::string> IOHandler::readInputFile(const std::string &filePath)
+std::vector<std::string> IOHandler::readInputFile(const std::string &filePath, bool &binary)
 {
-    std::ifstream file(filePath);
-    std::vector<std::string> hexValues(3);
-    if (file) file >> hexValues[0] >> hexValues[1] >> hexValues[2];
-    return hexValues;
+    TraceSpan Span("IOHandler::readInputFile", "io");
+    MappedInput file;
+    std::vector<std::string> values;
+    std::string_view value;
+    if (!file.open(filePath))
+        return values;
+    binary = file.isBinary();
+    if (!file.matchesRecordType(RECORD_KEY_VALUES))
+        throw("Binary Format Error: Input Is Not A Key Values File");
+    while (file.next(value))
+    {
+        if (binary && file.isNegative())
+            throw("Negative input values!");
+        values.push_back(std::string(binary ? BinaryFormat::trim(value) : value));
+    }
+    return values;
+}
+
+void IOHandler::processFile(const std::string &inputFile, const std::string &outputFile, bool useCarmichael, bool includeCrt, bool batchMode, size_t workers)
+{
+    if (!HelperFunctions::validateFile(inputFile))
+        throw("Invalid input file!");
+    bool binary = false;
+    std::vector<std::string> values = readInputFile(inputFile, binary);
+    if (values.size() < 3 || (batchMode && values.size() % 3 != 0) || (!binary && !HelperFunctions::areHexadecimal(values)))
+        throw("Non-hexadecimal or incomplete input values!");
+    bool written;
+    if (batchMode)
+        written = HandlerLargeNumbers::writeBatch(values, useCarmichael, binary, outputFile, workers);
+    else
+    {
+        const std::vector<std::string> primeValues(values.begin(), values.end() - 1);
+        MultiPrimeKey key = HandlerLargeNumbers::processMultiPrimeNumbers(primeValues, values.back(), binary, useCarmichael, includeCrt);
+        if (binary)
+            written = writeOutputFile(outputFile, HandlerLargeNumbers::encodeMultiPrimeKey(key, includeCrt));
+        else
+            written = writeOutputFile(outputFile, includeCrt ? HandlerLargeNumbers::formatMultiPrimeKey(key) : HandlerLargeNumbers::formatLargeNumber(key.privateExponent));
+    }
+    if (!written)
+        throw("Unable to write to output file!");
 }
 
 bool IOHandler::writeOutputFile(const std::string &filePath, const std::string &content)
 {
-    std::ofstream file(filePath);
+    TraceSpan Span("IOHandler::writeOutputFile", "io");
+    std::ofstream file(filePath, std::ios::binary);
     if (file)
     {
         file << content;
@@ -176,295 +219,100 @@ bool HelperFunctions::areHexadecimal(const std::vector<std::string> &values)
     return std::all_of(values.begin(), values.end(), isHexadecimal);
 }
 
-LargeNumber LargeNumberConversion::copyLargeNumber(const LargeNumber &number)
-{
-    LargeNumber Result;
-    Result.is_negative = number.is_negative;
-    for (int i = 0; i < 309; i++) Result.digits[i] = number.digits[i];
-    return Result;
-}
-
-LargeNumber LargeNumberConversion::addLeadingDigit(const LargeNumber &number, int digit)
-{
-    LargeNumber Result = number;
-    Result.is_negative = number.is_negative;
-    for (int i = 309 - 1; i > 0; --i) Result.digits[i] = Result.digits[i - 1];
-    Result.digits[0] = digit;
-    return Result;
-}
-
-bool LargeNumberConversion::isEqualToZero(const LargeNumber &number)
+LargeNumber HandlerLargeNumbers::processLargeNumbers(const std::string &hexP, const std::string &hexQ, const std::string &hexE)
 {
-    for (int i = 0; i < 309; i++)
-        if (number.digits[i] != 0)
-            return false;
-    return true;
+    return processMultiPrimeNumbers({hexP, hexQ}, hexE, false, false, false).privateExponent;
 }
 
-LargeNumber LargeNumberArithmetic::addLargeNumbers(LargeNumber first, LargeNumber second)
+LargeNumber HandlerLargeNumbers::parseValue(const std::string &value, bool binary)
 {
-    if (LargeNumberConversion::isEqualToZero(first)) return second;
-    if (LargeNumberConversion::isEqualToZero(second)) return first;
-    bool BothNegative = first.is_negative && second.is_negative;
-    if (first.is_negative)
-    {
-        first.is_negative = false;
-        return subtractLargeNumbers(second, first);
-    }
-    if (second.is_negative)
-    {
-        second.is_negative = false;
-        return subtractLargeNumbers(first, second);
-    }
-    LargeNumber Result;
-    int carry = 0;
-    for (int i = 0; i < Result.MAX_DIGITS; i++)
-    {
-        int sum = first.digits[i] + second.digits[i] + carry;
-        Result.digits[i] = sum % 100;
-        carry = sum / 100;
-    }
-    if (carry) Result.digits[Result.MAX_DIGITS - 1] = carry;
-    Result.is_negative = BothNegative;
-    return Result;
+    return binary ? BinaryFormat::toLargeNumber(value) : ConversionOperations::convertHexToLargeNumber(value);
 }
 
-LargeNumber LargeNumberArithmetic::subtractLargeNumbers(LargeNumber minuend, LargeNumber subtrahend)
+MultiPrimeKey HandlerLargeNumbers::processMultiPrimeNumbers(const std::vector<std::string> &primeValues, const std::string &exponentValue, bool binary, bool useCarmichael, bool includeCrt)
 {
-    if (LargeNumberConversion::isEqualToZero(subtrahend)) return minuend;
-    if (LargeNumberConversion::isEqualToZero(minuend))
-    {
-        subtrahend.is_negative = true;
-        return subtrahend;
-    }
-    if (subtrahend.is_negative)
-    {
-        if (minuend.is_negative)
-        {
-            minuend.is_negative = subtrahend.is_negative = false;
-            return subtractLargeNumbers(subtrahend, minuend);
-        }
-        subtrahend.is_negative = false;
-        return addLargeNumbers(minuend, subtrahend);
-    }
-    if (minuend.is_negative)
-    {
-        minuend.is_negative = subtrahend.is_negative = false;
-        LargeNumber result = addLargeNumbers(minuend, subtrahend);
-        result.is_negative = true;
-        return result;
-    }
-    LargeNumber Result = minuend;
-    bool borrow = false;
-    for (int i = 0; i < 309; i++)
-    {
-        int diff = Result.digits[i] - subtrahend.digits[i] - borrow;
-        if (diff < 0)
-        {
-            diff += 100;
-            borrow = true;
-        }
-        else
-            borrow = false;
-        Result.digits[i] = diff;
-    }
-    if (borrow)
+    TraceSpan Span("HandlerLargeNumbers::processMultiPrimeNumbers", "arithmetic");
+    MultiPrimeKey key;
+    LargeNumber E;
     {
-        LargeNumber temp = subtractLargeNumbers(subtrahend, minuend);
-        temp.is_negative = true;
-        return temp;
+        TraceSpan Conversion("HandlerLargeNumbers::parseValue", "conversion");
+        E = parseValue(exponentValue, binary);
     }
-    return Result;
-}
-
-LargeNumber LargeNumberArithmetic::multiplyLargeNumbers(LargeNumber first, LargeNumber second)
-{
-    if (LargeNumberConversion::isEqualToZero(first) || LargeNumberConversion::isEqualToZero(second))
-        return LargeNumber();
-    bool neg = first.is_negative ^ second.is_negative;
-    first.is_negative = second.is_negative = false;
-    LargeNumber Result;
-    for (int i = 0; i < 309; i++)
+    LargeNumber One;
+    One.digits[0] = 1;
+    key.modulus = One;
+    for (size_t i = 0; i < primeValues.size(); ++i)
     {
-        LargeNumber temp;
-        int carry = 0;
-        for (int j = 0; j < 309; j++)
         {
-            int val = first.digits[i] * second.digits[j] + carry;
-            carry = val / 100;
-            temp.digits[j] += val % 100;
+            TraceSpan Conversion("HandlerLargeNumbers::parseValue", "conversion", i);
+            key.primes.push_back(parseValue(primeValues[i], binary));
         }
-        for (int k = 309 - 1; k >= i; k--)
-            temp.digits[k] = temp.digits[k - i];
-        for (int k = 0; k < i; k++)
-            temp.digits[k] = 0;
-        Result = addLargeNumbers(Result, temp);
-    }
-    Result.is_negative = neg;
-    return Result;
-}
-
-DivisionResult LargeNumberArithmetic::divideBySmallNumber(LargeNumber dividend, LargeNumber divisor)
-{
-    DivisionResult Result;
-    if (LargeNumberConversion::isEqualToZero(dividend))
-    {
-        Result.quotient = dividend;
-        Result.remainder = dividend;
-        return Result;
+        key.modulus = LargeNumberArithmetic::multiplyLargeNumbers(key.modulus, key.primes.back());
     }
-    LargeNumber countArray, One, tempResult = dividend;
-    One.digits[0] = 1;
-    bool CheckNeg = tempResult.is_negative;
-    do
+    key.privateExponent = LargeNumberSpecialOperations::inverse(E, computeTotient(key.primes, useCarmichael));
+    if (!includeCrt || key.privateExponent.is_negative)
+        return key;
+    LargeNumber Product = One;
+    for (const auto &Prime : key.primes)
     {
-        tempResult = subtractLargeNumbers(tempResult, divisor);
-        CheckNeg = tempResult.is_negative;
-        if (countArray.digits[0] != 99) countArray.digits[0] = countArray.digits[0] + 1;
-        else countArray = addLargeNumbers(countArray, One);
-    } while (!CheckNeg);
-    if (countArray.digits[0] != 0)
-    {
-        countArray.digits[0] = countArray.digits[0] - 1;
-        Result.quotient = countArray;
+        key.exponents.push_back(LargeNumberSpecialOperations::reduceModulo(key.privateExponent, LargeNumberArithmetic::subtractLargeNumbers(Prime, One)));
+        key.coefficients.push_back(LargeNumberSpecialOperations::inverse(LargeNumberSpecialOperations::reduceModulo(Product, Prime), Prime));
+        Product = LargeNumberArithmetic::multiplyLargeNumbers(Product, Prime);
     }
-    else Result.quotient = subtractLargeNumbers(countArray, One);
-    Result.remainder = addLargeNumbers(tempResult, divisor);
-    return Result;
+    LargeNumber Message;
+    Message.digits[0] = 2;
+    LargeNumber Ciphertext = LargeNumberSpecialOperations::modularExponentiation(Message, E, key.modulus);
+    LargeNumber Decrypted = LargeNumberSpecialOperations::decryptMultiPrime(Ciphertext, key.primes, key.exponents, key.coefficients);
+    if (!LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(Decrypted, Message)))
+        throw("Key Error: CRT decryption round trip failed, the primes are not distinct primes");
+    return key;
 }
 
-DivisionResult LargeNumberArithmetic::divideByLargeNumber(LargeNumber dividend, LargeNumber divisor)
+std::vector<std::vector<size_t>> HandlerLargeNumbers::groupByModulus(const std::vector<std::string> &values)
 {
-    DivisionResult Result, tempResult;
-    LargeNumber partOffirst, test;
-    if (LargeNumberConversion::isEqualToZero(dividend))
-    {
-        Result.quotient = dividend;
-        Result.remainder = dividend;
-    }
-    bool neg = false;
-    if (dividend.is_negative && divisor.is_negative)
-    {
-        dividend.is_negative = false;
-        divisor.is_negative = false;
-    }
-    else if (dividend.is_negative)
-    {
-        dividend.is_negative = false;
-        neg = true;
-    }
-    else if (divisor.is_negative)
+    TraceSpan Span("HandlerLargeNumbers::groupByModulus", "arithmetic");
+    std::map<std::pair<std::string, std::string>, std::vector<size_t>> groups;
+    for (size_t i = 0; i + 2 < values.size(); i += 3)
     {
-        divisor.is_negative = false;
-        neg = true;
-    }
-    std::reverse(std::begin(dividend.digits), std::end(dividend.digits));
-    int i = 0;
-    while (i != 309) {
-        do {
-            partOffirst = LargeNumberConversion::addLeadingDigit(partOffirst, dividend.digits[i]);
-            test = subtractLargeNumbers(partOffirst, divisor);
-            i++;
-        } while (test.is_negative && i != 309);
-        tempResult = divideBySmallNumber(partOffirst, divisor);
-        Result.quotient.digits[309 - i] = tempResult.quotient.digits[0];
-        partOffirst = tempResult.remainder;
+        std::pair<std::string, std::string> primes = std::minmax(values[i], values[i + 1]);
+        groups[primes].push_back(i / 3);
     }
-    Result.remainder = partOffirst;
-    Result.remainder.is_negative = neg;
-    Result.quotient.is_negative = neg;
+    std::vector<std::vector<size_t>> Result;
+    for (auto &group : groups)
+        Result.push_back(std::move(group.second));
     return Result;
 }
 
-LargeNumber LargeNumberSpecialOperationsinverse(LargeNumber input, LargeNumber modulus)
+void HandlerLargeNumbers::processKeyGroup(const std::vector<std::string> &values, const std::vector<size_t> &keys, bool binary, bool useCarmichael, std::vector<LargeNumber> &inverses)
 {
-    LargeNumber Result, Q, A2, A3, B2, B3, T2, T3, Zero, One, temp;
-    One.digits[0] = 1;
-    A2 = LargeNumberConversion::copyLargeNumber(Zero);
-    A3 = LargeNumberConversion::copyLargeNumber(modulus);
-    B2 = LargeNumberConversion::copyLargeNumber(One);
-    B3 = LargeNumberConversion::copyLargeNumber(input);
-    while (!LargeNumberConversion::isEqualToZero(B3) && !LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(B3, One)))
-    {
-        Q = LargeNumberArithmetic::divideByLargeNumber(A3, B3).quotient;
-        T2 = LargeNumberArithmetic::subtractLargeNumbers(A2, LargeNumberArithmetic::multiplyLargeNumbers(Q, B2));
-        T3 = LargeNumberArithmetic::subtractLargeNumbers(A3, LargeNumberArithmetic::multiplyLargeNumbers(Q, B3));
-        A2 = LargeNumberConversion::copyLargeNumber(B2);
-        A3 = LargeNumberConversion::copyLargeNumber(B3);
-        B2 = LargeNumberConversion::copyLargeNumber(T2);
-        B3 = LargeNumberConversion::copyLargeNumber(T3);
-    }
-    if (LargeNumberConversion::isEqualToZero(B3))
-    {
-        LargeNumber res;
-        res.is_negative = true;
-        res.digits[0] = 1;
-        return res;
-    }
-    if (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(B3, One)))
-    {
-        while (B2.is_negative)
-            B2 = LargeNumberArithmetic::addLargeNumbers(B2, modulus);
-        Result = B2;
-        temp = LargeNumberArithmetic::subtractLargeNumbers(Result, modulus);
-        while (!temp.is_negative)
-        {
-            Result = temp;
-            temp = LargeNumberArithmetic::subtractLargeNumbers(Result, modulus);
-        }
-    }
-    return Result;
+    LatencyTimer Latency(LATENCY_KEY_GROUP);
+    std::vector<LargeNumber> primes = {parseValue(values[keys[0] * 3], binary), parseValue(values[keys[0] * 3 + 1], binary)};
+    LargeNumber Totient = computeTotient(primes, useCarmichael);
+    std::vector<LargeNumber> exponents;
+    for (size_t index : keys)
+        exponents.push_back(parseValue(values[index * 3 + 2], binary));
+    std::vector<LargeNumber> Result = LargeNumberSpecialOperations::batchInverse(exponents, Totient);
+    for (size_t i = 0; i < keys.size(); ++i)
+        inverses[keys[i]] = Result[i];
 }
 
-LargeNumber LargeNumberSpecialOperations::inverse(LargeNumber number, LargeNumber modulus)
+LargeNumber HandlerLargeNumbers::computeTotient(const std::vector<LargeNumber> &primes, bool useCarmichael)
 {
-    LargeNumber Result, Q, A2, A3, B2, B3, T2, T3, Zero, One, temp;
+    LargeNumber One;
     One.digits[0] = 1;
-    A2 = LargeNumberConversion::copyLargeNumber(Zero);
-    A3 = LargeNumberConversion::copyLargeNumber(modulus);
-    B2 = LargeNumberConversion::copyLargeNumber(One);
-    B3 = LargeNumberConversion::copyLargeNumber(number);
-    while (!LargeNumberConversion::isEqualToZero(B3) && !LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(B3, One)))
-    {
-        Q = LargeNumberArithmetic::divideByLargeNumber(A3, B3).quotient;
-        T2 = LargeNumberArithmetic::subtractLargeNumbers(A2, LargeNumberArithmetic::multiplyLargeNumbers(Q, B2));
-        T3 = LargeNumberArithmetic::subtractLargeNumbers(A3, LargeNumberArithmetic::multiplyLargeNumbers(Q, B3));
-        A2 = LargeNumberConversion::copyLargeNumber(B2);
-        A3 = LargeNumberConversion::copyLargeNumber(B3);
-        B2 = LargeNumberConversion::copyLargeNumber(T2);
-        B3 = LargeNumberConversion::copyLargeNumber(T3);
-    }
-    if (LargeNumberConversion::isEqualToZero(B3))
+    LargeNumber Totient = One;
+    for (const auto &Prime : primes)
     {
-        LargeNumber res;
-        res.is_negative = true;
-        res.digits[0] = 1;
-        return res;
-    }
-    if (LargeNumberConversion::isEqualToZero(LargeNumberArithmetic::subtractLargeNumbers(B3, One)))
-    {
-        while (B2.is_negative)
-            B2 = LargeNumberArithmetic::addLargeNumbers(B2, modulus);
-        Result = B2;
-        temp = LargeNumberArithmetic::subtractLargeNumbers(Result, modulus);
-        while (!temp.is_negative)
+        LargeNumber PrimeMinusOne = LargeNumberArithmetic::subtractLargeNumbers(Prime, One);
+        if (useCarmichael)
         {
-            Result = temp;
-            temp = LargeNumberArithmetic::subtractLargeNumbers(Result, modulus);
+            LargeNumber Divisor = LargeNumberSpecialOperations::greatestCommonDivisor(Totient, PrimeMinusOne);
+            Totient = LargeNumberArithmetic::multiplyLargeNumbers(LargeNumberArithmetic::divideByLargeNumber(Totient, Divisor).quotient, PrimeMinusOne);
         }
+        else
+            Totient = LargeNumberArithmetic::multiplyLargeNumbers(Totient, PrimeMinusOne);
     }
-    return Result;
-}
-
-LargeNumber HandlerLargeNumbers::processLargeNumbers(const std::string &hexP, const std::string &hexQ, const std::string &hexE)
-{
-    LargeNumber P = ConversionOperations::convertStringToLargeNumber(ConversionOperations::convertHexBigEndianToDecimal(hexP).toString());
-    LargeNumber Q = ConversionOperations::convertStringToLargeNumber(ConversionOperations::convertHexBigEndianToDecimal(hexQ).toString());
-    LargeNumber E = ConversionOperations::convertStringToLargeNumber(ConversionOperations::convertHexBigEndianToDecimal(hexE).toString());
-    LargeNumber One;
-    One.digits[0] = 1;
-    LargeNumber Phi = LargeNumberArithmetic::multiplyLargeNumbers(LargeNumberArithmetic::subtractLargeNumbers(P, One),LargeNumberArithmetic::subtractLargeNumbers(Q, One));
-    return LargeNumberSpecialOperations::inverse(E, Phi);
+    return Totient;
 }
 
 std::string HandlerLargeNumbers::formatLargeNumber(const LargeNumber &number)
@@ -472,358 +320,100 @@ std::string HandlerLargeNumbers::formatLargeNumber(const LargeNumber &number)
     return number.is_negative ? ConversionOperations::convertLargeNumberToString(number) : ConversionOperations::convertDecimalToHexBigEndian(number);
 }
 
-BigInteger::BigInteger(std::string &s)
-{
-    digits = "";
-    int n = s.size();
-    for (int i = n - 1; i >= 0; i--)
-    {
-        if (!isdigit(s[i])) throw("ERROR CONVERT");
-        else digits.push_back(s[i] - '0');
-    }
-}
-
-BigInteger::BigInteger(unsigned long long numConvert)
-{
-    do {
-        digits.push_back(numConvert % 10);
-        numConvert /= 10;
-    } while (numConvert != 0);
-}
-
-BigInteger::BigInteger(const char *s)
-{
-    std::string str = std::string(s);
-    digits = "";
-    for (int i = str.length() - 1; i >= 0; i--)
-    {
-        if (!isdigit(s[i])) throw("ERROR CONVERT");
-        else digits.push_back(s[i] - '0');
-    }
-}
-
-BigInteger::BigInteger(BigInteger &a)
-{
-    digits = a.digits;
-}
-
-BigInteger::BigInteger(const BigInteger &a)
-{
-    this->digits = a.digits;
-}
-
-bool Null(const BigInteger &a)
-{
-    return (a.digits.size() == 1 && a.digits[0] == 0);
-}
-
-int BigInteger::operator[](const int index) const
+std::string HandlerLargeNumbers::formatMultiPrimeKey(const MultiPrimeKey &key)
 {
-    if (digits.size() <= index || index < 0) throw("ERROR");
-    return digits[index];
+    TraceSpan Span("HandlerLargeNumbers::formatMultiPrimeKey", "format");
+    std::string output = formatLargeNumber(key.privateExponent);
+    for (size_t i = 0; i < key.exponents.size(); ++i)
+        output += "\n" + formatLargeNumber(key.exponents[i]) + " " + formatLargeNumber(key.coefficients[i]);
+    return output;
 }
 
-BigInteger &BigInteger::operator=(const BigInteger &a)
+std::string HandlerLargeNumbers::formatBatch(const std::vector<LargeNumber> &numbers)
 {
-    digits = a.digits;
-    return *this;
+    TraceSpan Span("HandlerLargeNumbers::formatBatch", "format");
+    std::string output;
+    for (size_t i = 0; i < numbers.size(); ++i)
+        output += (i ? "\n" : "") + formatLargeNumber(numbers[i]);
+    return output;
 }
-
-BigInteger &BigInteger::operator++()
-{
-    int i, n = digits.size();
-    for (i = 0; i < n && digits[i] == 9; i++) digits[i] = 0;
-    if (i == n) digits.push_back(1);
-    else digits[i]++;
-    return *this;
-}
-
-BigInteger BigInteger::operator++(int temp)
-{
-    BigInteger aux;
-    aux = *this;
-    ++(*this);
-    return aux;
-}
-
-BigInteger &operator+=(BigInteger &a, const BigInteger &b)
-{
-    int carry = 0, sum;
-    size_t n = a.digits.size(), m = b.digits.size();
-    if (m > n) a.digits.resize(m, 0);
-    for (size_t i = 0; i < m || carry; ++i)
-    {
-        if (i == a.digits.size())
-            a.digits.push_back(0);
-        sum = a.digits[i] + carry + (i < m ? b.digits[i] : 0);
-        a.digits[i] = sum % 10;
-        carry = sum / 10;
-    }
-    return a;
-}
-
-BigInteger operator+(const BigInteger &a, const BigInteger &b)
-{
-    BigInteger temp(a);
-    temp += b;
-    return temp;
-}
-
-BigInteger &BigInteger::operator--()
-{
-    if (digits[0] == 0 && digits.size() == 1) throw("UNDERFLOW");
-    int i, n = digits.size();
-    for (i = 0; digits[i] == 0 && i < n; i++) digits[i] = 9;
-    digits[i]--;
-    if (n > 1 && digits[n - 1] == 0) digits.pop_back();
-    return *this;
-}
-
-BigInteger BigInteger::operator--(int temp)
-{
-    BigInteger aux;
-    aux = *this;
-    --(*this);
-    return aux;
-}
-
-BigInteger &operator-=(BigInteger &a, const BigInteger &b)
+std::string HandlerLargeNumbers::encodeMultiPrimeKey(const MultiPrimeKey &key, bool includeCrt)
 {
-    if (a < b) throw("UNDERFLOW");
-    int n = a.digits.size(), m = b.digits.size(), t = 0;
-    for (int i = 0; i < n; i++)
+    TraceSpan Span("HandlerLargeNumbers::encodeMultiPrimeKey", "format");
+    std::string output = BinaryFormat::header(RECORD_PRIVATE_KEYS, includeCrt ? 1 + 2 * key.exponents.size() : 1);
+    BinaryFormat::appendLargeNumber(output, key.privateExponent);
+    for (size_t i = 0; includeCrt && i < key.exponents.size(); ++i)
     {
-        int s = a.digits[i] - (i < m ? b.digits[i] : 0) + t;
-        t = s < 0 ? -1 : 0;
-        a.digits[i] = s < 0 ? s + 10 : s;
+        BinaryFormat::appendLargeNumber(output, key.exponents[i]);
+        BinaryFormat::appendLargeNumber(output, key.coefficients[i]);
     }
-    while (n > 1 && a.digits[n - 1] == 0) a.digits.pop_back(), n--;
-    return a;
+    return output;
 }
-
-BigInteger operator-(const BigInteger &a, const BigInteger &b)
+std::string HandlerLargeNumbers::encodeBatch(const std::vector<LargeNumber> &numbers)
 {
-    BigInteger temp;
-    temp = a;
-    temp -= b;
-    return temp;
+    TraceSpan Span("HandlerLargeNumbers::encodeBatch", "format");
+    std::string output;
+    for (const LargeNumber &number : numbers)
+        BinaryFormat::appendLargeNumber(output, number);
+    return output;
 }
-
-BigInteger operator*(const BigInteger &a, const BigInteger &b)
+bool HandlerLargeNumbers::writeBatch(const std::vector<std::string> &values, bool useCarmichael, bool binary, const std::string &filePath, size_t workers)
 {
-    BigInteger temp;
-    temp = a;
-    temp *= b;
-    return temp;
-}
+    const size_t CHUNK_KEYS = 32;
+    size_t keyCount = values.size() / 3;
+    std::vector<std::vector<size_t>> groups = groupByModulus(values);
+    std::vector<LargeNumber> inverses(keyCount);
 
-BigInteger &operator*=(BigInteger &a, const BigInteger &b)
-{
-    if (Null(a) || Null(b))
+    // Chunks hold whole modulus groups so keys sharing p and q always meet in one batchInverse;
+    // every key belongs to exactly one group, so workers fill disjoint slots of inverses.
+    std::vector<size_t> chunkStarts;
+    size_t chunkKeys = 0;
+    for (size_t group = 0; group < groups.size(); ++group)
     {
-        a = BigInteger();
-        return a;
-    }
-    int n = a.digits.size(), m = b.digits.size();
-    std::vector<int> v(n + m, 0);
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < m; j++)
-            v[i + j] += a.digits[i] * b.digits[j];
-    a.digits.resize(n + m);
-    int carry = 0;
-    for (int i = 0; i < a.digits.size(); i++)
-    {
-        v[i] += carry;
-        a.digits[i] = v[i] % 10;
-        carry = v[i] / 10;
-    }
-    while (a.digits.size() > 1 && a.digits.back() == 0) a.digits.pop_back();
-    return a;
-}
-
-BigInteger &operator/=(BigInteger &a, const BigInteger &b)
-{
-    if (Null(b))
-        throw("Arithmetic Error: Division By 0");
-    if (a < b)
-    {
-        a = BigInteger();
-        return a;
-    }
-    int n = a.digits.size(), m = b.digits.size();
-    std::vector<int> quotient(n, 0);
-    BigInteger temp;
-    for (int i = n - 1; i >= 0; --i)
-    {
-        temp = temp * 10 + a.digits[i];
-        int divisor = 0;
-        while (b < temp || b == temp)
+        if (chunkStarts.empty() || chunkKeys + groups[group].size() > CHUNK_KEYS)
         {
-            temp -= b;
-            ++divisor;
+            chunkStarts.push_back(group);
+            chunkKeys = 0;
         }
-        quotient[n - i - 1] = divisor;
-    }
-    a.digits.clear();
-    for (int digit : quotient)
-        a.digits.push_back(digit);
-    return a;
-}
-
-BigInteger operator/(const BigInteger &a, const BigInteger &b)
-{
-    BigInteger temp;
-    temp = a;
-    temp /= b;
-    return temp;
-}
-
-BigInteger &operator%=(BigInteger &a, const BigInteger &b)
-{
-    if (Null(b))
-        throw("Arithmetic Error: Division By 0");
-    if (a < b)
-        return a;
-    if (a == b)
-    {
-        a = BigInteger();
-        return a;
+        chunkKeys += groups[group].size();
     }
-    int n = a.digits.size();
-    BigInteger t;
-    for (int i = n - 1; t * 10 + a.digits[i] < b; i--)
+    chunkStarts.push_back(groups.size());
+    Utils::parallelFor(chunkStarts.size() - 1, [&](size_t chunk)
     {
-        t *= 10;
-        t += a.digits[i];
-    }
-    for (int i = n - 1; i >= 0; i--)
-    {
-        t = t * 10 + a.digits[i];
-        int cc = 0;
-        while (b < t || b == t)
+        for (size_t group = chunkStarts[chunk]; group < chunkStarts[chunk + 1]; ++group)
         {
-            t -= b;
-            ++cc;
+            TraceSpan Group("keyGroup", "message", group);
+            processKeyGroup(values, groups[group], binary, useCarmichael, inverses);
         }
-    }
-    a = t;
-    return a;
-}
-
-BigInteger operator%(const BigInteger &a, const BigInteger &b)
-{
-    BigInteger temp;
-    temp = a;
-    temp %= b;
-    return temp;
-}
-
-std::string BigInteger::toString()
-{
-    std::string res = "";
-    for (int i = this->digits.size() - 1; i >= 0; i--)
-        res = res + std::to_string((short)this->digits[i]);
-    return res;
-}
-
-bool operator==(const BigInteger &a, const BigInteger &b)
-{
-    return a.digits == b.digits;
-}
-
-bool operator<(const BigInteger &a, const BigInteger &b)
-{
-    size_t n = a.digits.size(), m = b.digits.size();
-    if (n != m)
-        return n < m;
-    for (size_t i = n; i-- > 0;)
-        if (a.digits[i] != b.digits[i])
-            return a.digits[i] < b.digits[i];
-    return false;
-}
-
-LargeNumber ConversionOperations::convertStringToLargeNumber(const std::string &str)
-{
-    LargeNumber final;
-    std::string temp = str;
-    final.is_negative = (temp[0] == '-');
-    if (final.is_negative)
-        temp.erase(0, 1);
-    std::reverse(temp.begin(), temp.end());
-    int val = 0, multiplier = 1, digit_index = 0;
-    for (char c : temp)
-    {
-        val += (c - '0') * multiplier;
-        multiplier *= 10;
-        if (multiplier == 100)
+    }, workers);
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file)
+        return false;
+    size_t nextKey = 0;
+    bool first = true;
+    if (binary)
+        file << BinaryFormat::header(RECORD_PRIVATE_KEYS, keyCount);
+    Pipeline::run<size_t, std::string>(
+        [&](size_t &firstKey)
         {
-            final.digits[digit_index++] = val;
-            val = 0;
-            multiplier = 1;
-        }
-    }
-    if (val > 0)
-        final.digits[digit_index] = val;
-    return final;
-}
-
-std::string ConversionOperations::convertDecimalToHexBigEndian(LargeNumber decimal)
-{
-    if (LargeNumberConversion::isEqualToZero(decimal))
-        return "0";
-    std::string res;
-    LargeNumber Sixteen;
-    Sixteen.digits[0] = 16;
-    while (!LargeNumberConversion::isEqualToZero(decimal))
-    {
-        int rem = LargeNumberArithmetic::divideByLargeNumber(decimal, Sixteen).remainder.digits[0];
-        res = (rem < 10) ? std::to_string(rem) + res : std::string(1, 'A' + rem - 10) + res;
-        decimal = LargeNumberArithmetic::divideByLargeNumber(decimal, Sixteen).quotient;
-    }
-    return res;
-}
-
-BigInteger ConversionOperations::convertHexBigEndianToDecimal(std::string hexVal)
-{
-    int len = hexVal.size();
-    BigInteger base("1");
-    BigInteger dec_val("0");
-    for (int i = len - 1; i >= 0; i--)
-    {
-        if (hexVal[i] >= '0' && hexVal[i] <= '9')
+            firstKey = nextKey;
+            nextKey = std::min(keyCount, nextKey + CHUNK_KEYS);
+            return firstKey < keyCount;
+        },
+        [&](size_t &firstKey)
         {
-            dec_val += (hexVal[i] - '0') * base;
-            base = base * 16;
-        }
-        else if (hexVal[i] >= 'A' && hexVal[i] <= 'F')
+            TraceSpan Span("keyChunk", "format", firstKey);
+            size_t lastKey = std::min(keyCount, firstKey + CHUNK_KEYS);
+            std::vector<LargeNumber> numbers(std::make_move_iterator(inverses.begin() + firstKey), std::make_move_iterator(inverses.begin() + lastKey));
+            return binary ? encodeBatch(numbers) : formatBatch(numbers);
+        },
+        [&](std::string &formatted)
         {
-            dec_val += (hexVal[i] - '7') * base;
-            base = base * 16;
-        }
-    }
-    return dec_val;
+            TraceSpan Span("IOHandler::writeOutputFile", "io");
+            file << (first || binary ? "" : "\n") << formatted;
+            first = false;
+        },
+        workers);
+    return bool(file);
 }
-
-std::string ConversionOperations::convertLargeNumberToString(LargeNumber input)
-{
-    std::string out;
-    if (input.is_negative)
-        out += "-";
-    std::reverse(input.digits.begin(), input.digits.end());
-    bool leadingZero = true;
-    for (int i = 0; i < 309; ++i)
-    {
-        int value = input.digits[i];
-        for (int div = 10; div > 0; div /= 10)
-        {
-            int digit = value / div;
-            value %= div;
-            if (digit != 0 || !leadingZero)
-            {
-                out += (digit + '0');
-                leadingZero = false;
-            }
-        }
-    }
-    return out.empty() || out == "-" ? "0" : out;
-}
\ No newline at end of file
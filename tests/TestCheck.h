@@ -0,0 +1,27 @@
+#ifndef RSA_BIGNUM_TEST_CHECK_H
+#define RSA_BIGNUM_TEST_CHECK_H
+
+#include <iostream>
+
+namespace TestCheck
+{
+    inline int failures = 0;
+
+    inline void expect(bool condition, const char *description)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << description << std::endl;
+            ++failures;
+        }
+    }
+
+    inline int result()
+    {
+        if (failures)
+            std::cerr << failures << " checks failed" << std::endl;
+        return failures ? 1 : 0;
+    }
+}
+
+#endif
@@ -0,0 +1,132 @@
+#include "TestCheck.h"
+#include "rsa_bignum/BinaryFormat.h"
+#include "rsa_bignum/ConversionOperations.h"
+#include "rsa_bignum/MappedInput.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::mt19937_64 generator(20240302);
+
+    std::string randomHex(size_t digits)
+    {
+        std::string Result;
+        Result.push_back("123456789ABCDEF"[generator() % 15]);
+        while (Result.size() < digits)
+            Result.push_back("0123456789ABCDEF"[generator() % 16]);
+        return Result;
+    }
+
+    bool sameNumber(const LargeNumber &first, const LargeNumber &second)
+    {
+        return first.is_negative == second.is_negative && LargeNumberConversion::toDigitVector(first) == LargeNumberConversion::toDigitVector(second);
+    }
+
+    void checkHeaders()
+    {
+        for (RecordType type : {RECORD_CANDIDATES, RECORD_PRIVATE_KEYS, RECORD_SHARED_FACTORS})
+            for (unsigned long long count : {0ULL, 1ULL, 0x0123456789ABCDEFULL})
+            {
+                RecordType readType;
+                unsigned long long readCount;
+                std::string header = BinaryFormat::header(type, count);
+                TestCheck::expect(header.size() == BinaryFormat::HEADER_SIZE, "header has the fixed size");
+                TestCheck::expect(BinaryFormat::readHeader(header, readType, readCount) && readType == type && readCount == count, "header round-trips type and count");
+            }
+        RecordType type;
+        unsigned long long count;
+        std::string header = BinaryFormat::header(RECORD_MESSAGES, 3);
+        TestCheck::expect(!BinaryFormat::readHeader(header.substr(0, BinaryFormat::HEADER_SIZE - 1), type, count), "a truncated header is rejected");
+        header[0] = 'X';
+        TestCheck::expect(!BinaryFormat::readHeader(header, type, count), "a header with the wrong magic is rejected");
+        TestCheck::expect(!BinaryFormat::readHeader("3 5 7 11 13 17 19", type, count), "text input is not taken for a header");
+    }
+
+    void checkRecords()
+    {
+        std::vector<std::string> hexValues = {"0", "1", "FF", "100", "-2A", "00000ABC"};
+        for (size_t digits : {15, 16, 17, 64, 128, 513, 2048})
+            hexValues.push_back(randomHex(digits));
+        std::string encoded;
+        for (const std::string &hex : hexValues)
+            BinaryFormat::appendHex(encoded, hex);
+        BinaryFormat::appendInteger(encoded, -123456789);
+        BinaryFormat::appendInteger(encoded, 0x7FFFFFFFFFFFFFFFLL);
+
+        size_t position = 0;
+        std::string_view magnitude;
+        bool negative;
+        for (const std::string &hex : hexValues)
+        {
+            bool expectNegative = hex[0] == '-';
+            std::string expected = expectNegative ? hex.substr(1) : hex;
+            expected.erase(0, std::min(expected.find_first_not_of('0'), expected.size() - 1));
+            TestCheck::expect(BinaryFormat::readRecord(encoded, position, magnitude, negative), "every appended record can be read back");
+            TestCheck::expect(BinaryFormat::toHex(magnitude) == expected && negative == expectNegative, "hex records round-trip");
+        }
+        TestCheck::expect(BinaryFormat::readRecord(encoded, position, magnitude, negative) && BinaryFormat::toInteger(magnitude, negative) == -123456789, "negative integers round-trip");
+        TestCheck::expect(BinaryFormat::readRecord(encoded, position, magnitude, negative) && BinaryFormat::toInteger(magnitude, negative) == 0x7FFFFFFFFFFFFFFFLL, "the largest integer round-trips");
+        TestCheck::expect(position == encoded.size() && !BinaryFormat::readRecord(encoded, position, magnitude, negative), "reading stops at the end");
+
+        std::string truncated;
+        BinaryFormat::appendHex(truncated, randomHex(40));
+        truncated.pop_back();
+        position = 0;
+        TestCheck::expect(!BinaryFormat::readRecord(truncated, position, magnitude, negative) && position == 0, "a truncated record is rejected");
+    }
+
+    void checkLargeNumbers()
+    {
+        for (size_t digits : {1, 2, 15, 16, 17, 31, 64, 256, 1024})
+            for (bool negative : {false, true})
+            {
+                LargeNumber Number = ConversionOperations::convertHexToLargeNumber(randomHex(digits));
+                Number.is_negative = negative;
+                std::string encoded;
+                BinaryFormat::appendLargeNumber(encoded, Number);
+                size_t position = 0;
+                std::string_view magnitude;
+                bool readNegative;
+                TestCheck::expect(BinaryFormat::readRecord(encoded, position, magnitude, readNegative), "LargeNumber records can be read back");
+                TestCheck::expect(sameNumber(BinaryFormat::toLargeNumber(magnitude, readNegative), Number), "LargeNumber records round-trip");
+                std::vector<unsigned long long> limbs = BinaryFormat::toLimbs(Number);
+                TestCheck::expect(sameNumber(BinaryFormat::fromLimbs(limbs.data(), limbs.size(), negative), Number), "limbs round-trip");
+            }
+    }
+
+    void checkMappedInput()
+    {
+        std::vector<std::string> hexValues;
+        std::string encoded = BinaryFormat::header(RECORD_KEY_VALUES, 3);
+        for (size_t digits : {64, 64, 5})
+        {
+            hexValues.push_back(randomHex(digits));
+            BinaryFormat::appendHex(encoded, hexValues.back());
+        }
+        const std::string path = (std::filesystem::temp_directory_path() / ("rsa_binary_format_test_" + std::to_string(generator()))).string();
+        std::ofstream(path, std::ios::binary) << encoded;
+        MappedInput input;
+        TestCheck::expect(input.open(path) && input.isBinary() && input.recordType() == RECORD_KEY_VALUES && input.recordCount() == 3, "MappedInput recognizes a binary file");
+        TestCheck::expect(input.matchesRecordType(RECORD_KEY_VALUES) && !input.matchesRecordType(RECORD_PRIVATE_KEYS), "only the header's record type matches");
+        std::string_view token;
+        for (const std::string &hex : hexValues)
+            TestCheck::expect(input.next(token) && BinaryFormat::toHex(token) == hex, "MappedInput yields the records in order");
+        TestCheck::expect(!input.next(token), "MappedInput stops after the last record");
+        std::remove(path.c_str());
+    }
+}
+
+int main()
+{
+    checkHeaders();
+    checkRecords();
+    checkLargeNumbers();
+    checkMappedInput();
+    return TestCheck::result();
+}
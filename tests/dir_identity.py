@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""Check that --dir, with threads and with processes, writes the same bytes as one invocation per file."""
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+TOOLS = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir, "tools")
+
+
+def read(path):
+    with open(path, "rb") as handle:
+        return handle.read()
+
+
+def run(command):
+    result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+    if result.returncode != 0:
+        raise RuntimeError(f"{' '.join(command)} exited {result.returncode}: {result.stderr.decode(errors='replace')}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--build", required=True, help="directory holding task1/task2/task3")
+    args = parser.parse_args()
+
+    failures = 0
+    with tempfile.TemporaryDirectory(prefix="rsa_dir_identity_") as root:
+        corpus = os.path.join(root, "corpus")
+        run([sys.executable, os.path.join(TOOLS, "generate_corpus.py"), "--output", corpus, "--seed", "7",
+             "--task1-bits", "512", "--task1-count", "2", "--task2-bits", "256", "--task2-count", "4",
+             "--task2-batch", "40", "--task3-bits", "512", "--task3-counts", "20,50", "--batch-gcd-count", "20"])
+        with open(os.path.join(corpus, "manifest.json")) as handle:
+            cases = json.load(handle)["cases"]
+
+        groups = {}
+        for case in cases:
+            groups.setdefault((case["task"], tuple(case["args"])), []).append(case)
+        for (task, extra), group in sorted(groups.items()):
+            binary = os.path.join(args.build, task)
+            label = " ".join((task,) + extra)
+            inputs = os.path.join(root, "in", label.replace(" ", "_"))
+            os.makedirs(inputs)
+            single = {}
+            for case in group:
+                name = os.path.basename(case["input"])
+                shutil.copy(os.path.join(corpus, case["input"]), os.path.join(inputs, name))
+                output = os.path.join(root, "single_" + name)
+                run([binary, os.path.join(inputs, name), output] + list(extra))
+                single[name] = read(output)
+                if single[name] != read(os.path.join(corpus, case["expected"])):
+                    print(f"FAILED: {label} {name} differs from the expected output")
+                    failures += 1
+            for mode in (["--jobs", "2"], ["--processes", "2"]):
+                outputs = os.path.join(root, "out", label.replace(" ", "_") + mode[0])
+                run([binary, inputs, outputs, "--dir"] + mode + list(extra))
+                for name, expected in single.items():
+                    path = os.path.join(outputs, name)
+                    if not os.path.exists(path) or read(path) != expected:
+                        print(f"FAILED: {label} --dir {' '.join(mode)} {name} differs from the single-file run")
+                        failures += 1
+            print(f"{label}: {len(group)} file(s) checked")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,70 @@
+#include "TestCheck.h"
+#include "rsa_bignum/ArithmeticBackend.h"
+#include "rsa_bignum/Benchmark.h"
+#include "rsa_bignum/LargeNumberArithmetic.h"
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    std::mt19937_64 generator(20240301);
+
+    std::vector<int> randomDigits(size_t size, bool allNines = false)
+    {
+        std::vector<int> Result(size);
+        for (auto &value : Result)
+            value = allNines ? LargeNumberArithmetic::DIGIT_BASE - 1 : generator() % LargeNumberArithmetic::DIGIT_BASE;
+        if (!Result.empty() && Result.back() == 0)
+            Result.back() = 1;
+        return Result;
+    }
+
+    void compareMultiply(const std::vector<int> &first, const std::vector<int> &second)
+    {
+        TestCheck::expect(NativeBackend::multiply(first, second) == GmpBackend::multiply(first, second), "multiply matches GMP");
+    }
+
+    void compareDivide(const std::vector<int> &dividend, const std::vector<int> &divisor)
+    {
+        DigitDivisionResult native = NativeBackend::divide(dividend, divisor), gmp = GmpBackend::divide(dividend, divisor);
+        TestCheck::expect(native.quotient == gmp.quotient && native.remainder == gmp.remainder, "divide matches GMP");
+    }
+
+    void comparePowerModulo(const std::vector<int> &base, const std::vector<int> &exponent, const std::vector<int> &modulus)
+    {
+        TestCheck::expect(NativeBackend::powerModulo(base, exponent, modulus) == GmpBackend::powerModulo(base, exponent, modulus), "powerModulo matches GMP");
+    }
+}
+
+int main()
+{
+    const std::vector<int> Zero, One = {1};
+    compareMultiply(Zero, randomDigits(40));
+    compareMultiply(One, randomDigits(40));
+    compareDivide(Zero, randomDigits(5));
+    compareDivide(randomDigits(5), randomDigits(40));
+    compareDivide(randomDigits(40, true), One);
+    comparePowerModulo(randomDigits(10), Zero, randomDigits(10));
+    comparePowerModulo(Zero, randomDigits(3), randomDigits(10));
+
+    // Sizes straddle the schoolbook, Karatsuba, Toom-3 and NTT crossovers.
+    const std::vector<size_t> sizes = {1, 2, 3, 7, 31, 32, 33, 64, 65, 127, 300, 1000, 3000, 12000};
+    for (size_t first : sizes)
+        for (size_t second : sizes)
+        {
+            if (first * second > 12000 * 1000)
+                continue;
+            compareMultiply(randomDigits(first), randomDigits(second));
+            compareMultiply(randomDigits(first, true), randomDigits(second, true));
+            compareDivide(randomDigits(first), randomDigits(second));
+            compareDivide(randomDigits(first + second, true), randomDigits(second));
+        }
+    for (size_t size : {1, 2, 5, 20, 60, 160})
+    {
+        comparePowerModulo(randomDigits(size), randomDigits(size), randomDigits(size));
+        comparePowerModulo(randomDigits(2 * size), randomDigits(size), randomDigits(size, true));
+    }
+    TestCheck::expect(Benchmark::compareBackends(std::cout, 200), "random-size comparison has no mismatches");
+    return TestCheck::result();
+}
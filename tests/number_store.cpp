@@ -0,0 +1,170 @@
+#include "TestCheck.h"
+#include "rsa_bignum/BinaryFormat.h"
+#include "rsa_bignum/NumberStore.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const uint64_t CHECKSUM_SEED = 14695981039346656037ULL;
+
+    struct StoreImage
+    {
+        NumberStoreHeader header;
+        std::vector<unsigned long long> limbs;
+        std::vector<NumberStoreEntry> index;
+    };
+
+    std::mt19937_64 generator(20240303);
+    const std::string Path = (std::filesystem::temp_directory_path() / ("rsa_number_store_test_" + std::to_string(generator()))).string();
+
+    // Same layout as tools/build_number_store.py: header, fixed-width limb rows, then the index.
+    StoreImage buildImage(const std::vector<std::vector<unsigned long long>> &numbers, const std::vector<bool> &negative, uint64_t width)
+    {
+        StoreImage Result;
+        std::memset(&Result.header, 0, sizeof(Result.header));
+        std::memcpy(Result.header.magic, "RSASTORE", 8);
+        Result.header.version = NumberStore::VERSION;
+        Result.header.limbBits = 64;
+        Result.header.width = width;
+        Result.header.count = numbers.size();
+        for (size_t i = 0; i < numbers.size(); ++i)
+        {
+            size_t used = numbers[i].size();
+            while (used && numbers[i][used - 1] == 0)
+                --used;
+            Result.index.push_back({Result.limbs.size(), uint32_t(used), negative[i] ? NumberStore::FLAG_NEGATIVE : 0});
+            Result.limbs.insert(Result.limbs.end(), numbers[i].begin(), numbers[i].end());
+            Result.limbs.resize(Result.limbs.size() + width - numbers[i].size());
+        }
+        Result.header.limbsOffset = sizeof(NumberStoreHeader);
+        Result.header.indexOffset = Result.header.limbsOffset + 8 * Result.limbs.size();
+        uint64_t digest = NumberStore::checksum(Result.limbs.data(), Result.limbs.size(), CHECKSUM_SEED);
+        Result.header.checksum = NumberStore::checksum(reinterpret_cast<const unsigned long long *>(Result.index.data()), Result.index.size() * sizeof(NumberStoreEntry) / 8, digest);
+        return Result;
+    }
+
+    void writeImage(const StoreImage &image, size_t truncate = 0)
+    {
+        std::string bytes(reinterpret_cast<const char *>(&image.header), sizeof(image.header));
+        bytes.append(reinterpret_cast<const char *>(image.limbs.data()), 8 * image.limbs.size());
+        bytes.append(reinterpret_cast<const char *>(image.index.data()), sizeof(NumberStoreEntry) * image.index.size());
+        bytes.resize(bytes.size() - truncate);
+        std::ofstream(Path, std::ios::binary) << bytes;
+    }
+
+    bool opens(const StoreImage &image, size_t truncate = 0)
+    {
+        writeImage(image, truncate);
+        NumberStore store;
+        return store.open(Path);
+    }
+
+    void checkContents()
+    {
+        std::vector<std::vector<unsigned long long>> numbers;
+        std::vector<bool> negative;
+        const uint64_t width = 8;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            std::vector<unsigned long long> limbs(1 + generator() % width);
+            for (auto &limb : limbs)
+                limb = generator();
+            numbers.push_back(limbs);
+            negative.push_back(i % 5 == 0);
+        }
+        numbers.push_back({0});
+        negative.push_back(false);
+        writeImage(buildImage(numbers, negative, width));
+
+        NumberStore store;
+        TestCheck::expect(store.open(Path) && store.verify(), "a well-formed store opens and verifies");
+        TestCheck::expect(store.size() == numbers.size() && store.width() == width, "size and width come from the header");
+        bool same = true;
+        for (size_t i = 0; i < numbers.size(); ++i)
+        {
+            LargeNumber Expected = BinaryFormat::fromLimbs(numbers[i].data(), numbers[i].size(), negative[i]);
+            LargeNumber Actual = store[i].toLargeNumber();
+            same = same && Actual.is_negative == Expected.is_negative && LargeNumberConversion::toDigitVector(Actual) == LargeNumberConversion::toDigitVector(Expected);
+            same = same && store[i].toBigInteger().toDigitVector() == LargeNumberConversion::toDigitVector(Expected);
+        }
+        TestCheck::expect(same, "every view decodes to the stored number");
+
+        std::vector<std::atomic<int>> visits(store.size());
+        store.forEachChunk(7, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                ++visits[i];
+        });
+        bool once = true;
+        for (const auto &count : visits)
+            once = once && count == 1;
+        TestCheck::expect(once, "forEachChunk visits every entry exactly once");
+
+        bool thrown = false;
+        try
+        {
+            store[store.size()];
+        }
+        catch (const char *)
+        {
+            thrown = true;
+        }
+        TestCheck::expect(thrown, "an out-of-range position throws");
+    }
+
+    void checkCorruption()
+    {
+        std::vector<std::vector<unsigned long long>> numbers = {{1, 2}, {3}, {4, 5, 6}};
+        std::vector<bool> negative = {false, true, false};
+        StoreImage image = buildImage(numbers, negative, 3);
+        TestCheck::expect(opens(image), "the reference image opens");
+
+        StoreImage flipped = image;
+        flipped.limbs[1] ^= 1;
+        writeImage(flipped);
+        {
+            NumberStore store;
+            TestCheck::expect(store.open(Path) && !store.verify(), "a flipped limb fails the checksum");
+        }
+
+        StoreImage wrapping = image;
+        wrapping.index[1].offset = ~0ULL;
+        wrapping.index[1].size = 1;
+        TestCheck::expect(!opens(wrapping), "an offset whose end wraps past 2^64 is rejected");
+
+        StoreImage outside = image;
+        outside.index[2].offset = 8;
+        TestCheck::expect(!opens(outside), "an entry running past the limb area is rejected");
+
+        StoreImage wide = image;
+        wide.index[0].size = 4;
+        TestCheck::expect(!opens(wide), "an entry wider than the row is rejected");
+
+        StoreImage overflow = image;
+        overflow.header.width = 1ULL << 62;
+        overflow.header.count = 8;
+        TestCheck::expect(!opens(overflow), "a count * width that overflows is rejected");
+
+        StoreImage version = image;
+        version.header.version = NumberStore::VERSION + 1;
+        TestCheck::expect(!opens(version), "an unknown version is rejected");
+
+        TestCheck::expect(!opens(image, 8), "a truncated index is rejected");
+        TestCheck::expect(!NumberStore::isStore("0123456789ABCDEF 0123456789ABCDEF 0123456789ABCDEF"), "text input is not taken for a store");
+    }
+}
+
+int main()
+{
+    checkContents();
+    checkCorruption();
+    std::remove(Path.c_str());
+    return TestCheck::result();
+}
@@ -0,0 +1,111 @@
+#include "TestCheck.h"
+#include "rsa_bignum/Pipeline.h"
+#include "rsa_bignum/Utils.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    void checkOrdering(size_t count, size_t workers, size_t capacity)
+    {
+        size_t next = 0;
+        std::vector<size_t> written;
+        Pipeline::run<size_t, size_t>(
+            [&](size_t &record)
+            {
+                record = next++;
+                return record < count;
+            },
+            [](size_t &record)
+            {
+                // Uneven work so later records regularly finish before earlier ones.
+                if (record % 7 == 0)
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                else if (record % 3 == 0)
+                    std::this_thread::yield();
+                return record * record;
+            },
+            [&](size_t &result)
+            {
+                written.push_back(result);
+            },
+            workers, capacity);
+        bool ordered = written.size() == count;
+        for (size_t i = 0; ordered && i < count; ++i)
+            ordered = written[i] == i * i;
+        TestCheck::expect(ordered, "results are written in read order");
+    }
+
+    void checkEmptyInput()
+    {
+        size_t writes = 0;
+        Pipeline::run<int, int>([](int &) { return false; }, [](int &record) { return record; }, [&](int &) { ++writes; }, 3);
+        TestCheck::expect(writes == 0, "an empty input writes nothing");
+    }
+
+    void checkErrorPropagation()
+    {
+        size_t next = 0, writes = 0;
+        bool caught = false;
+        try
+        {
+            Pipeline::run<size_t, size_t>(
+                [&](size_t &record)
+                {
+                    record = next++;
+                    return record < 1000;
+                },
+                [](size_t &record)
+                {
+                    if (record == 500)
+                        throw("Pipeline Test Error: compute failed");
+                    return record;
+                },
+                [&](size_t &)
+                {
+                    ++writes;
+                },
+                4, 8);
+        }
+        catch (const char *message)
+        {
+            caught = std::strcmp(message, "Pipeline Test Error: compute failed") == 0;
+        }
+        TestCheck::expect(caught, "a compute exception is rethrown by run");
+        TestCheck::expect(writes <= 500, "nothing after the failed record is written");
+    }
+
+    void checkNestedParallelFor()
+    {
+        std::atomic<bool> sameThread(true);
+        std::atomic<size_t> calls(0);
+        Utils::parallelFor(4, [&](size_t)
+        {
+            std::thread::id outer = std::this_thread::get_id();
+            Utils::parallelFor(8, [&](size_t)
+            {
+                if (std::this_thread::get_id() != outer)
+                    sameThread = false;
+                ++calls;
+            }, 8);
+        }, 4);
+        TestCheck::expect(sameThread && calls == 32, "a parallelFor inside a worker runs serially on that worker");
+        TestCheck::expect(!Utils::ParallelRegion::inside(), "the caller is outside a region once parallelFor returns");
+    }
+}
+
+int main()
+{
+    checkOrdering(5000, 1, 64);
+    checkOrdering(5000, 4, 2);
+    checkOrdering(20000, 8, 16);
+    checkOrdering(100, size_t(-1), 4);
+    checkEmptyInput();
+    checkErrorPropagation();
+    checkNestedParallelFor();
+    return TestCheck::result();
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""Pack hex numbers into a memory-mappable number store (see README, "Number store")."""
+import argparse
+import struct
+import sys
+
+MAGIC = b"RSASTORE"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQQQQQQ")
+ENTRY = struct.Struct("<QII")
+CHECKSUM_SEED = 14695981039346656037
+CHECKSUM_PRIME = 1099511628211
+MASK = (1 << 64) - 1
+
+
+def checksum(words, seed):
+    value = seed
+    for word in words:
+        value = ((value ^ word) * CHECKSUM_PRIME) & MASK
+    return value
+
+
+def read_numbers(path, public_keys):
+    with open(path) as handle:
+        tokens = handle.read().split()
+    if public_keys:
+        count = int(tokens[0])
+        return [int(tokens[1 + 2 * i], 16) for i in range(count)]
+    return [int(token, 16) for token in tokens]
+
+
+def build(numbers, width_bits):
+    widest = max([abs(n).bit_length() for n in numbers] + [1])
+    width = (max(width_bits, widest) + 63) // 64
+    limbs, entries = [], []
+    for number in numbers:
+        magnitude = abs(number)
+        words = [(magnitude >> (64 * i)) & MASK for i in range(width)]
+        used = width
+        while used and words[used - 1] == 0:
+            used -= 1
+        entries.append((len(limbs), used, 1 if number < 0 else 0))
+        limbs.extend(words)
+    limbs_offset = HEADER.size
+    index_offset = limbs_offset + 8 * len(limbs)
+    index = b"".join(ENTRY.pack(*entry) for entry in entries)
+    index_words = struct.unpack("<%dQ" % (len(index) // 8), index)
+    digest = checksum(index_words, checksum(limbs, CHECKSUM_SEED))
+    header = HEADER.pack(MAGIC, VERSION, 64, width, len(numbers), limbs_offset, index_offset, digest, 0)
+    return header + struct.pack("<%dQ" % len(limbs), *limbs) + index
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("input", help="whitespace-separated hex numbers, or a task3 --batch-gcd file with --public-keys")
+    parser.add_argument("output")
+    parser.add_argument("--public-keys", action="store_true", help="read moduli from a task3 --batch-gcd input")
+    parser.add_argument("--width-bits", type=int, default=0, help="record width (default: widest number)")
+    args = parser.parse_args()
+    data = build(read_numbers(args.input, args.public_keys), args.width_bits)
+    with open(args.output, "wb") as handle:
+        handle.write(data)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
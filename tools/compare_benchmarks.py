@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+"""Compare two rsa_bench JSON result files and flag regressions."""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as handle:
+        return {entry["name"]: entry for entry in json.load(handle)["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown of median ns/op counted as a regression (default 0.10)")
+    parser.add_argument("--metric", default="median_ns", choices=["median_ns", "mean_ns", "min_ns"])
+    args = parser.parse_args()
+
+    baseline, current = load(args.baseline), load(args.current)
+    regressions = 0
+    print(f"{'benchmark':<44}{'baseline':>16}{'current':>16}{'change':>10}")
+    for name, entry in current.items():
+        if name not in baseline:
+            print(f"{name:<44}{'-':>16}{entry[args.metric]:>16.1f}{'new':>10}")
+            continue
+        before, after = baseline[name][args.metric], entry[args.metric]
+        change = (after - before) / before if before > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  improvement"
+        print(f"{name:<44}{before:>16.1f}{after:>16.1f}{change:>+10.1%}{flag}")
+    for name in baseline:
+        if name not in current:
+            print(f"{name:<44}{baseline[name][args.metric]:>16.1f}{'-':>16}{'missing':>10}")
+    print(f"{regressions} regression(s) beyond {args.threshold:.0%}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Convert task files between the text (hex) format and the binary record format."""
+import argparse
+import struct
+import sys
+
+MAGIC = b"RSAB"
+VERSION = 1
+NEGATIVE_FLAG = 0x80000000
+
+RECORD_TYPES = {
+    "candidates": 1,
+    "primality-results": 2,
+    "key-values": 3,
+    "private-keys": 4,
+    "messages": 5,
+    "message-indices": 6,
+    "public-keys": 7,
+    "shared-factors": 8,
+}
+
+# Number of leading tokens that are decimal counts rather than hex values.
+DECIMAL_PREFIX = {"messages": 2, "public-keys": 1}
+
+
+def encode_value(value):
+    magnitude = abs(value)
+    data = magnitude.to_bytes((magnitude.bit_length() + 7) // 8, "big")
+    return struct.pack(">I", len(data) | (NEGATIVE_FLAG if value < 0 else 0)) + data
+
+
+def encode(text, kind):
+    tokens = text.split()
+    prefix = DECIMAL_PREFIX.get(kind, 0)
+    values = [int(token, 10 if i < prefix else 16) for i, token in enumerate(tokens)]
+    header = MAGIC + struct.pack(">BBHQ", VERSION, RECORD_TYPES[kind], 0, len(values))
+    return header + b"".join(encode_value(value) for value in values)
+
+
+def decode_values(data):
+    if data[:4] != MAGIC or data[4] != VERSION:
+        raise ValueError("not a binary record file")
+    kind = {code: name for name, code in RECORD_TYPES.items()}.get(data[5], str(data[5]))
+    position, values = 16, []
+    while position + 4 <= len(data):
+        (prefix,) = struct.unpack_from(">I", data, position)
+        length = prefix & ~NEGATIVE_FLAG
+        value = int.from_bytes(data[position + 4:position + 4 + length], "big")
+        values.append(-value if prefix & NEGATIVE_FLAG else value)
+        position += 4 + length
+    return kind, values
+
+
+def hex_or_decimal(value):
+    return str(value) if value < 0 else format(value, "X")
+
+
+def decode(data):
+    """Render results the way the task binaries print them in text mode."""
+    kind, values = decode_values(data)
+    if kind == "primality-results":
+        return "\n".join(str(value) for value in values) + ("\n" if len(values) > 1 else "")
+    if kind == "message-indices":
+        return "".join("%d " % value for value in values)
+    if kind == "shared-factors":
+        return "".join("%d %X\n" % (values[i], values[i + 1]) for i in range(0, len(values), 2))
+    if kind == "private-keys":
+        return "\n".join(hex_or_decimal(value) for value in values)
+    prefix = DECIMAL_PREFIX.get(kind, 0)
+    return "\n".join(str(value) if i < prefix else format(value, "X") for i, value in enumerate(values)) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("mode", choices=["encode", "decode"])
+    parser.add_argument("input")
+    parser.add_argument("output")
+    parser.add_argument("--type", choices=sorted(RECORD_TYPES), help="record type when encoding")
+    args = parser.parse_args()
+    if args.mode == "encode":
+        if not args.type:
+            parser.error("--type is required when encoding")
+        with open(args.input) as handle:
+            data = encode(handle.read(), args.type)
+        with open(args.output, "wb") as handle:
+            handle.write(data)
+    else:
+        with open(args.input, "rb") as handle:
+            text = decode(handle.read())
+        with open(args.output, "w") as handle:
+            handle.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
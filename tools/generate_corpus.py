@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""Generate task input files with known-good outputs for end-to-end benchmarks."""
+import argparse
+import json
+import math
+import os
+import random
+import sys
+
+SMALL_PRIMES = [p for p in range(3, 2000) if all(p % q for q in range(2, int(p ** 0.5) + 1))]
+
+
+def is_probable_prime(n, rng, rounds=16):
+    if n < 2:
+        return False
+    for p in SMALL_PRIMES:
+        if n % p == 0:
+            return n == p
+    d, s = n - 1, 0
+    while d % 2 == 0:
+        d //= 2
+        s += 1
+    for _ in range(rounds):
+        x = pow(rng.randrange(2, n - 1), d, n)
+        if x in (1, n - 1):
+            continue
+        for _ in range(s - 1):
+            x = x * x % n
+            if x == n - 1:
+                break
+        else:
+            return False
+    return True
+
+
+def random_prime(rng, bits):
+    while True:
+        n = rng.getrandbits(bits) | (1 << (bits - 1)) | 1
+        if is_probable_prime(n, rng):
+            return n
+
+
+def task1_answer(n):
+    """Base-2 strong probable-prime test, the check task1 implements."""
+    if n < 3 or n % 2 == 0:
+        return 0
+    d, s = n - 1, 0
+    while d % 2 == 0:
+        d //= 2
+        s += 1
+    x = pow(2, d, n)
+    if x in (1, n - 1):
+        return 1
+    for _ in range(s - 1):
+        x = x * x % n
+        if x == n - 1:
+            return 1
+        if x == 1:
+            return 0
+    return 0
+
+
+def task2_answer(p, q, e):
+    phi = (p - 1) * (q - 1)
+    return "%X" % pow(e, -1, phi) if math.gcd(e, phi) == 1 else "-1"
+
+
+class Corpus:
+    def __init__(self, root):
+        self.root = root
+        self.cases = []
+
+    def add(self, task, name, text, expected, items, args=()):
+        directory = os.path.join(self.root, task)
+        os.makedirs(directory, exist_ok=True)
+        input_path = os.path.join(directory, name + ".in")
+        expected_path = os.path.join(directory, name + ".out")
+        with open(input_path, "w") as handle:
+            handle.write(text)
+        with open(expected_path, "w") as handle:
+            handle.write(expected)
+        self.cases.append({
+            "name": f"{task}/{name}",
+            "task": task,
+            "input": os.path.relpath(input_path, self.root),
+            "expected": os.path.relpath(expected_path, self.root),
+            "args": list(args),
+            "items": items,
+            "input_bytes": len(text),
+        })
+        print(f"  {task}/{name}: {items} item(s), {len(text)} bytes", file=sys.stderr)
+
+    def save(self, seed):
+        with open(os.path.join(self.root, "manifest.json"), "w") as handle:
+            json.dump({"seed": seed, "cases": self.cases}, handle, indent=2)
+            handle.write("\n")
+
+
+def generate_task1(corpus, rng, bits, count):
+    for i in range(count):
+        prime = random_prime(rng, bits)
+        corpus.add("task1", f"prime_{bits}_{i:03d}", "%X\n" % prime, str(task1_answer(prime)), 1)
+        semiprime = random_prime(rng, bits // 2) * random_prime(rng, bits - bits // 2)
+        corpus.add("task1", f"semiprime_{bits}_{i:03d}", "%X\n" % semiprime, str(task1_answer(semiprime)), 1)
+        odd = rng.getrandbits(bits) | (1 << (bits - 1)) | 1
+        corpus.add("task1", f"random_{bits}_{i:03d}", "%X\n" % odd, str(task1_answer(odd)), 1)
+
+
+def generate_task2(corpus, rng, bits, count, batch):
+    for i in range(count):
+        p, q = random_prime(rng, bits), random_prime(rng, bits)
+        corpus.add("task2", f"key_{bits}_{i:03d}", "%X %X %X\n" % (p, q, 65537), task2_answer(p, q, 65537), 1)
+    if batch:
+        pairs = [(random_prime(rng, bits), random_prime(rng, bits)) for _ in range(max(1, batch // 8))]
+        lines, answers = [], []
+        for _ in range(batch):
+            p, q = rng.choice(pairs)
+            e = rng.choice([3, 17, 65537, rng.getrandbits(32) | 1])
+            lines.append("%X %X %X" % (p, q, e))
+            answers.append(task2_answer(p, q, e))
+        corpus.add("task2", f"batch_{bits}_{batch}", "\n".join(lines) + "\n", "\n".join(answers), batch, ["--batch"])
+
+
+def generate_task3(corpus, rng, bits, counts):
+    p = random_prime(rng, bits // 2)
+    q = random_prime(rng, bits - bits // 2)
+    modulus, exponent = p * q, 65537
+    for count in counts:
+        messages = [rng.randrange(modulus) for _ in range(count)]
+        ciphertexts = ["%X" % pow(m, exponent, modulus) for m in messages]
+        dropped = set(rng.sample(range(count), count // 10))
+        kept = [c for i, c in enumerate(ciphertexts) if i not in dropped]
+        rng.shuffle(kept)
+        kept.extend("%X" % rng.getrandbits(bits - 1) for _ in range(count // 20))
+        position = {}
+        for index, c in enumerate(kept):
+            position.setdefault(c, index)
+        text = "%d %d\n%X %X\n%s\n%s\n" % (count, len(kept), modulus, exponent,
+                                          " ".join("%X" % m for m in messages), " ".join(kept))
+        expected = "".join("%d " % position.get(c, -1) for c in ciphertexts)
+        corpus.add("task3", f"messages_{bits}_{count}", text, expected, count)
+
+
+def generate_batch_gcd(corpus, rng, bits, count):
+    used, moduli = [], []
+    for i in range(count):
+        first = rng.choice(used) if i % 10 == 9 else random_prime(rng, bits // 2)
+        used.append(first)
+        moduli.append(first * random_prime(rng, bits - bits // 2))
+    product = 1
+    for n in moduli:
+        product *= n
+    expected = ""
+    for i, n in enumerate(moduli):
+        factor = math.gcd(n, product // n)
+        if factor != 1:
+            expected += "%d %X\n" % (i, factor)
+    text = "%d\n%s" % (count, "".join("%X %X\n" % (n, 65537) for n in moduli))
+    corpus.add("task3", f"batch_gcd_{bits}_{count}", text, expected, count, ["--batch-gcd"])
+
+
+def parse_counts(value):
+    return [int(item) for item in value.split(",") if item]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--output", default="corpus", help="corpus directory (default: corpus)")
+    parser.add_argument("--seed", type=int, default=20240229)
+    parser.add_argument("--task1-bits", type=int, default=2048)
+    parser.add_argument("--task1-count", type=int, default=2, help="primes, semiprimes and random odds each")
+    parser.add_argument("--task2-bits", type=int, default=1024, help="size of p and q")
+    parser.add_argument("--task2-count", type=int, default=4)
+    parser.add_argument("--task2-batch", type=int, default=256, help="triples in the --batch file, 0 to skip")
+    parser.add_argument("--task3-bits", type=int, default=2048, help="modulus size")
+    parser.add_argument("--task3-counts", type=parse_counts, default=[10000, 100000],
+                        help="comma-separated message counts, e.g. 10000,100000,1000000")
+    parser.add_argument("--batch-gcd-count", type=int, default=200, help="moduli in the --batch-gcd file, 0 to skip")
+    parser.add_argument("--tasks", default="task1,task2,task3")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    corpus = Corpus(args.output)
+    tasks = args.tasks.split(",")
+    if "task1" in tasks:
+        generate_task1(corpus, rng, args.task1_bits, args.task1_count)
+    if "task2" in tasks:
+        generate_task2(corpus, rng, args.task2_bits, args.task2_count, args.task2_batch)
+    if "task3" in tasks:
+        generate_task3(corpus, rng, args.task3_bits, args.task3_counts)
+        if args.batch_gcd_count:
+            generate_batch_gcd(corpus, rng, args.task3_bits, args.batch_gcd_count)
+    corpus.save(args.seed)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Time the task binaries on a generated corpus and record wall time, peak RSS and throughput."""
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+
+POLL_INTERVAL_S = 0.002
+
+
+def read_high_water(handle):
+    """Return VmHWM in kB from an open /proc/<pid>/status, or 0 once the process has released its memory."""
+    try:
+        handle.seek(0)
+        for line in handle.read().splitlines():
+            if line.startswith(b"VmHWM:"):
+                return int(line.split()[1])
+    except OSError:
+        pass
+    return 0
+
+
+def run_once(command):
+    # ru_maxrss carries the forking interpreter's footprint across exec, so peak RSS comes from the
+    # task's own VmHWM instead. The high-water mark only grows, so polling misses at most the last
+    # interval before exit. ru_maxrss, an upper bound, is the fallback when no sample could be taken.
+    with tempfile.TemporaryFile() as stderr_file:
+        start = time.perf_counter()
+        process = subprocess.Popen(command, stdout=subprocess.DEVNULL, stderr=stderr_file)
+        try:
+            status_file = open(f"/proc/{process.pid}/status", "rb")
+        except OSError:
+            status_file = None
+        peak_rss = 0
+        while True:
+            pid, status, usage = os.wait4(process.pid, os.WNOHANG)
+            if pid:
+                break
+            if status_file:
+                peak_rss = max(peak_rss, read_high_water(status_file))
+            time.sleep(POLL_INTERVAL_S)
+        elapsed = time.perf_counter() - start
+        if status_file:
+            status_file.close()
+        if not peak_rss:
+            peak_rss = usage.ru_maxrss
+        process.returncode = os.waitstatus_to_exitcode(status)
+        stderr_file.seek(0)
+        stderr = stderr_file.read().decode(errors="replace")
+    return elapsed, peak_rss, process.returncode, stderr
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--build", default="build/release", help="directory holding task1/task2/task3")
+    parser.add_argument("--corpus", default="corpus")
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--filter", default="", help="only run cases whose name contains this string")
+    parser.add_argument("--json", help="write results to this file (readable by compare_benchmarks.py)")
+    parser.add_argument("extra", nargs="*", help="extra arguments appended to every task invocation")
+    args = parser.parse_args()
+
+    with open(os.path.join(args.corpus, "manifest.json")) as handle:
+        manifest = json.load(handle)
+
+    results, failures = [], 0
+    print(f"{'case':<40}{'wall_s':>10}{'rss_mb':>10}{'items/s':>14}{'MB/s':>10}  status")
+    with tempfile.TemporaryDirectory() as scratch:
+        output_path = os.path.join(scratch, "output")
+        for case in manifest["cases"]:
+            if args.filter and args.filter not in case["name"]:
+                continue
+            binary = os.path.join(args.build, case["task"])
+            command = [binary, os.path.join(args.corpus, case["input"]), output_path] + case["args"] + args.extra
+            samples, peak_rss, status = [], 0, "ok"
+            for _ in range(max(1, args.repeat)):
+                elapsed, rss, code, stderr = run_once(command)
+                samples.append(elapsed)
+                peak_rss = max(peak_rss, rss)
+                if code != 0:
+                    status = f"exit {code}: {stderr.strip()[:60]}"
+                    break
+                with open(output_path) as produced, open(os.path.join(args.corpus, case["expected"])) as expected:
+                    if produced.read() != expected.read():
+                        status = "WRONG OUTPUT"
+                        break
+            if status != "ok":
+                failures += 1
+            median = statistics.median(samples)
+            entry = {
+                "name": case["name"],
+                "task": case["task"],
+                "args": case["args"] + args.extra,
+                "repetitions": len(samples),
+                "samples_s": samples,
+                "median_ns": median * 1e9,
+                "mean_ns": statistics.mean(samples) * 1e9,
+                "min_ns": min(samples) * 1e9,
+                "peak_rss_kb": peak_rss,
+                "items": case["items"],
+                "items_per_sec": case["items"] / median if median > 0 else 0.0,
+                "input_bytes": case["input_bytes"],
+                "status": status,
+            }
+            results.append(entry)
+            print(f"{case['name']:<40}{median:>10.3f}{peak_rss / 1024:>10.1f}{entry['items_per_sec']:>14.1f}"
+                  f"{case['input_bytes'] / median / 1e6 if median > 0 else 0:>10.2f}  {status}")
+
+    if args.json:
+        with open(args.json, "w") as handle:
+            json.dump({"context": {"build": args.build, "corpus": args.corpus, "seed": manifest.get("seed"),
+                                   "extra_args": args.extra}, "benchmarks": results}, handle, indent=2)
+            handle.write("\n")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())